@@ -0,0 +1,160 @@
+import argparse
+import itertools
+import os
+import random
+
+# --- Synthetic hypergraphs with a CORUM-like profile ---
+#
+# Every hyperedge draws its size from a size distribution, then fills it with
+# distinct vertices. CORUM sizes are not drawn independently: the n hyperedges
+# take the sizes at the n evenly spaced quantiles of CORUM's histogram, in
+# random order. A small scale therefore leaves out the rarest large complexes
+# instead of picking one up by chance, the largest size grows with the scale,
+# and scale 1 reproduces CORUM's sizes exactly, so the clique-expansion edges
+# grow with the scale as well. With probability OVERLAP a member is a vertex already in
+# some hyperedge: half of those picks are in proportion to the number of
+# hyperedges it belongs to (so popular proteins keep joining new complexes, as
+# in CORUM), half are uniform over the vertices used so far. Otherwise the
+# member is a vertex not used yet, or a uniform pick once every vertex has been
+# used. The default overlap is CORUM's share of memberships that repeat a
+# protein, 1 - 2799 / 9015; the half-and-half mix keeps the largest vertex
+# degree near CORUM's 71.
+#
+# The output uses the formats prepare_corum_data.py writes:
+#   <name>.hypergraph - one hyperedge per line, member IDs separated by spaces
+#   <name>.graph      - "nodes edges", then one "u v" line per clique-expansion edge
+# Vertex IDs are renumbered 0, 1, 2, ... in first-seen order, like gene symbols.
+
+# CORUM (gene_set_library_crisp.gmt): 2799 proteins in 2075 complexes with
+# 9015 memberships
+CORUM_VERTICES = 2799
+CORUM_HYPEREDGES = 2075
+CORUM_MEMBERSHIPS = 9015
+CORUM_HYPERGRAPH = os.path.join(os.path.dirname(os.path.abspath(__file__)), '..', 'data', 'corum_dataset.hypergraph')
+DEFAULT_OVERLAP = round(1 - CORUM_VERTICES / CORUM_MEMBERSHIPS, 2)
+
+
+def corum_sizes(path=CORUM_HYPERGRAPH):
+    """Hyperedge sizes of the CORUM dataset, to sample from."""
+    with open(path, 'r') as f:
+        return [len(line.split()) for line in f if line.strip()]
+
+
+def size_sampler(spec, rng, count):
+    """Returns a function drawing the sizes of `count` hyperedges.
+
+    spec is one of:
+      corum               CORUM's size histogram at `count` evenly spaced
+                          quantiles, shuffled (default)
+      fixed:K             every hyperedge has K members
+      geometric:MEAN      1 + geometric, mean size MEAN
+      powerlaw:ALPHA:MAX  P(k) ~ k^-ALPHA for 1 <= k <= MAX
+    """
+    kind, _, args = spec.partition(':')
+    if kind == 'corum':
+        sizes = sorted(corum_sizes())
+        picks = [sizes[int((i + 0.5) * len(sizes) / count)] for i in range(count)]
+        rng.shuffle(picks)
+        return iter(picks).__next__
+    if kind == 'fixed':
+        k = int(args)
+        return lambda: k
+    if kind == 'geometric':
+        p = 1.0 / max(float(args), 1.0)
+        def draw():
+            k = 1
+            while rng.random() > p:
+                k += 1
+            return k
+        return draw
+    if kind == 'powerlaw':
+        alpha, top = args.split(':')
+        ks = list(range(1, int(top) + 1))
+        weights = [k ** -float(alpha) for k in ks]
+        return lambda: rng.choices(ks, weights)[0]
+    raise ValueError(f"Unknown size distribution '{spec}'")
+
+
+def generate(vertices, hyperedges, sizes='corum', overlap=DEFAULT_OVERLAP, seed=1):
+    """Returns a list of hyperedges (lists of vertex IDs in first-seen order)."""
+    rng = random.Random(seed)
+    draw_size = size_sampler(sizes, rng, hyperedges)
+    memberships = []  # one entry per (vertex, hyperedge) pair: degree-proportional picks
+    used = []
+    fresh = list(range(vertices))
+    rng.shuffle(fresh)
+    edges = []
+    for _ in range(hyperedges):
+        k = min(draw_size(), vertices)
+        members = set()
+        while len(members) < k:
+            if memberships and rng.random() < overlap:
+                v = rng.choice(memberships) if rng.random() < 0.5 else rng.choice(used)
+            elif fresh:
+                v = fresh.pop()
+                used.append(v)
+            else:
+                v = rng.randrange(vertices)
+            members.add(v)
+        members = sorted(members)
+        memberships.extend(members)
+        edges.append(members)
+
+    # Renumber in first-seen order, as prepare_corum_data.py numbers genes
+    renumber = {}
+    for e in edges:
+        for v in e:
+            if v not in renumber:
+                renumber[v] = len(renumber)
+    return [[renumber[v] for v in e] for e in edges]
+
+
+def write_dataset(edges, out_dir, name):
+    """Writes <name>.hypergraph and its clique expansion <name>.graph.
+
+    Returns (nodes, graph edges, memberships)."""
+    os.makedirs(out_dir, exist_ok=True)
+    hypergraph_path = os.path.join(out_dir, f'{name}.hypergraph')
+    graph_path = os.path.join(out_dir, f'{name}.graph')
+
+    with open(hypergraph_path, 'w') as f:
+        for e in edges:
+            f.write(" ".join(map(str, e)) + "\n")
+
+    pairwise_edges = set()
+    for e in edges:
+        for u, v in itertools.combinations(e, 2):
+            pairwise_edges.add((min(u, v), max(u, v)))
+    nodes = len({v for e in edges for v in e})
+    with open(graph_path, 'w') as f:
+        f.write(f"{nodes} {len(pairwise_edges)}\n")
+        for u, v in sorted(pairwise_edges):
+            f.write(f"{u} {v}\n")
+
+    return nodes, len(pairwise_edges), sum(len(e) for e in edges)
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Generate a synthetic hypergraph and its clique expansion.')
+    parser.add_argument('--vertices', type=int, default=CORUM_VERTICES)
+    parser.add_argument('--hyperedges', type=int, default=None,
+                        help='default: vertices * %d / %d, the CORUM ratio' % (CORUM_HYPEREDGES, CORUM_VERTICES))
+    parser.add_argument('--sizes', default='corum', help='corum | fixed:K | geometric:MEAN | powerlaw:ALPHA:MAX')
+    parser.add_argument('--overlap', type=float, default=DEFAULT_OVERLAP,
+                        help='probability a member is a vertex already in some hyperedge')
+    parser.add_argument('--seed', type=int, default=1)
+    parser.add_argument('--out-dir', default='data')
+    parser.add_argument('--name', default='synthetic')
+    args = parser.parse_args()
+
+    hyperedges = args.hyperedges
+    if hyperedges is None:
+        hyperedges = max(1, round(args.vertices * CORUM_HYPEREDGES / CORUM_VERTICES))
+    edges = generate(args.vertices, hyperedges, args.sizes, args.overlap, args.seed)
+    nodes, graph_edges, memberships = write_dataset(edges, args.out_dir, args.name)
+    print(f"{args.name}: {nodes} nodes, {len(edges)} hyperedges, {memberships} memberships, "
+          f"{graph_edges} clique-expansion edges.")
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,156 @@
+import argparse
+import csv
+import json
+import os
+import subprocess
+import sys
+import time
+
+from generate_hypergraph import CORUM_HYPEREDGES, CORUM_VERTICES, DEFAULT_OVERLAP, generate, write_dataset
+
+# --- Scale sweep over synthetic CORUM-like hypergraphs ---
+#
+# For every scale s the sweep generates a hypergraph with s * 2799 vertices
+# (and the CORUM vertex/hyperedge ratio) plus its clique expansion, runs the
+# centrality programs on it, and reads back the first line of every output
+# file: "<heap bytes> <time> <peak RSS bytes> ...". Results go to
+# <out>.csv and <out>.json, one row per scale, representation and measure.
+#
+# Throughput is edges per second of the measure's time: clique-expansion
+# edges for the graph (ungraph), vertex-hyperedge memberships (the bipartite
+# edges) for the hypergraph (cmty).
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+SOURCE_DIR = os.path.join(HERE, '..')
+MEASURES = ['Betweenness', 'Closeness', 'Farness', 'Harmonic', 'Degree', 'PageRank']
+PROGRAMS = {
+    'all': ['all-centrality'],
+    'separate': ['betweenness-centrality', 'closeness-farness-harmonic-centrality', 'degree-centrality',
+                 'pagerank-centrality'],
+}
+# Programs that spread their sources over --threads; the others reject the flag
+THREADED = {'all-centrality', 'betweenness-centrality'}
+CXXFLAGS = ['-std=c++17', '-O2', '-pthread']
+
+
+def build(programs, bin_dir, cxx):
+    """Compiles each program from the sources next to this folder into bin_dir.
+
+    A binary is rebuilt when it is older than its .cpp or than any header in
+    the source folder, since every program includes the shared headers.
+    """
+    os.makedirs(bin_dir, exist_ok=True)
+    headers = [os.path.getmtime(os.path.join(SOURCE_DIR, name))
+               for name in os.listdir(SOURCE_DIR) if name.endswith('.h')]
+    newest_header = max(headers, default=0)
+    for program in programs:
+        source = os.path.join(SOURCE_DIR, f'{program}.cpp')
+        target = os.path.join(bin_dir, program)
+        newest_source = max(os.path.getmtime(source), newest_header)
+        if os.path.exists(target) and os.path.getmtime(target) >= newest_source:
+            continue
+        print(f"Compiling {program}...")
+        subprocess.run([cxx] + CXXFLAGS + ['-o', target, source], check=True)
+
+
+def prepare_run_dir(run_dir, name):
+    """Creates dataset_init.txt and the Output/<Measure>/ folders the programs expect."""
+    for measure in MEASURES:
+        os.makedirs(os.path.join(run_dir, 'Output', measure), exist_ok=True)
+    with open(os.path.join(run_dir, 'dataset_init.txt'), 'w') as f:
+        f.write(f"Synthetic benchmark {name}\n")
+        f.write(f"data/{name}.graph\n")
+        f.write(f"data/{name}.hypergraph\n")
+        f.write(f"{name}\n")
+
+
+def read_header(path):
+    """Returns (heap bytes, seconds, peak RSS bytes) from an output file's first line."""
+    with open(path, 'r') as f:
+        fields = f.readline().split()
+    return int(fields[0]), float(fields[1]), int(fields[2])
+
+
+def main():
+    parser = argparse.ArgumentParser(description='Time every centrality on both representations across a size sweep.')
+    parser.add_argument('--scales', default='0.25,0.5,1,2', help='comma-separated multiples of the CORUM vertex count')
+    parser.add_argument('--sizes', default='corum', help='hyperedge size distribution (see generate_hypergraph.py)')
+    parser.add_argument('--overlap', type=float, default=DEFAULT_OVERLAP)
+    parser.add_argument('--seed', type=int, default=1)
+    parser.add_argument('--programs', choices=sorted(PROGRAMS), default='all',
+                        help='all: the unified driver; separate: one program per measure family')
+    parser.add_argument('--threads', type=int, default=1)
+    parser.add_argument('--repeat', type=int, default=1, help='runs per scale; the fastest is kept')
+    parser.add_argument('--cache', action='store_true', help='let the programs use their binary .csr snapshots')
+    parser.add_argument('--cxx', default='g++')
+    parser.add_argument('--bin-dir', default=os.path.join(HERE, 'bin'))
+    parser.add_argument('--work-dir', default=os.path.join(HERE, 'runs'))
+    parser.add_argument('--out', default=os.path.join(HERE, 'results'), help='writes <out>.csv and <out>.json')
+    args = parser.parse_args()
+
+    programs = PROGRAMS[args.programs]
+    build(programs, args.bin_dir, args.cxx)
+    flags = [] if args.cache else ['--no-cache']
+
+    rows = []
+    for scale in [float(s) for s in args.scales.split(',') if s]:
+        vertices = max(2, round(scale * CORUM_VERTICES))
+        hyperedges = max(1, round(vertices * CORUM_HYPEREDGES / CORUM_VERTICES))
+        name = f'synthetic_{vertices}'
+        run_dir = os.path.join(args.work_dir, name)
+        edges = generate(vertices, hyperedges, args.sizes, args.overlap, args.seed)
+        nodes, graph_edges, memberships = write_dataset(edges, os.path.join(run_dir, 'data'), name)
+        prepare_run_dir(run_dir, name)
+        print(f"Scale {scale}: {nodes} nodes, {len(edges)} hyperedges, {memberships} memberships, "
+              f"{graph_edges} clique-expansion edges")
+
+        best = {}
+        for _ in range(args.repeat):
+            for program in programs:
+                begin = time.perf_counter()
+                threads = [f'--threads={args.threads}'] if program in THREADED else []
+                subprocess.run([os.path.join(os.path.abspath(args.bin_dir), program)] + flags + threads, cwd=run_dir,
+                               stdout=subprocess.DEVNULL, check=True)
+                print(f"  {program}: {time.perf_counter() - begin:.3f} s")
+            for measure in MEASURES:
+                for representation in ('ungraph', 'cmty'):
+                    path = os.path.join(run_dir, 'Output', measure, f'{name}.{representation}.{measure.lower()}.txt')
+                    if not os.path.exists(path):
+                        continue
+                    result = read_header(path)
+                    key = (measure, representation)
+                    if key not in best or result[1] < best[key][1]:
+                        best[key] = result
+
+        for (measure, representation), (heap, seconds, rss) in sorted(best.items()):
+            edge_count = graph_edges if representation == 'ungraph' else memberships
+            rows.append({
+                'scale': scale,
+                'sizes': args.sizes,
+                'overlap': args.overlap,
+                'representation': representation,
+                'measure': measure.lower(),
+                'nodes': nodes,
+                'hyperedges': len(edges),
+                'edges': edge_count,
+                'time_seconds': seconds,
+                'heap_peak_bytes': heap,
+                'peak_rss_bytes': rss,
+                'edges_per_second': edge_count / seconds if seconds > 0 else None,
+            })
+
+    if not rows:
+        print("No results were produced.", file=sys.stderr)
+        return 1
+    with open(f'{args.out}.csv', 'w', newline='') as f:
+        writer = csv.DictWriter(f, fieldnames=list(rows[0]))
+        writer.writeheader()
+        writer.writerows(rows)
+    with open(f'{args.out}.json', 'w') as f:
+        json.dump({'programs': args.programs, 'threads': args.threads, 'seed': args.seed, 'results': rows}, f, indent=2)
+    print(f"Wrote {len(rows)} rows to {args.out}.csv and {args.out}.json")
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,54 @@
+import mmap
+import struct
+import sys
+
+# --- Reader for the columnar result files written by all-centrality --columnar ---
+#
+# Output/<name>.<ungraph|cmty>.columns.bin holds every measure of one
+# representation as a column of float64 over the same rows (node IDs sorted
+# ascending), so tools can map it instead of reparsing the .txt files:
+#
+#   header | names (16-byte, NUL-padded) | ids (int32) | column 0 | column 1 | ...
+#
+# The header is: magic "CENTCOLS", uint32 version, uint32 columns, uint64 rows,
+# and the uint64 byte offsets of the names, ids and first column.
+
+MAGIC = b'CENTCOLS'
+HEADER = struct.Struct('=8sIIQQQQ')
+NAME_SIZE = 16
+
+
+def read_columns(path):
+    """Maps a columns file; returns (ids, {measure: values}).
+
+    ids and values are memoryviews over the mapping (int32 and float64), so
+    nothing is copied until they are indexed."""
+    with open(path, 'rb') as f:
+        data = mmap.mmap(f.fileno(), 0, access=mmap.ACCESS_READ)
+    magic, version, columns, rows, names_at, ids_at, columns_at = HEADER.unpack_from(data, 0)
+    if magic != MAGIC or version != 1:
+        raise ValueError(f"'{path}' is not a version 1 columns file")
+    view = memoryview(data)
+    ids = view[ids_at:ids_at + 4 * rows].cast('i')
+    result = {}
+    for c in range(columns):
+        name = bytes(view[names_at + c * NAME_SIZE:names_at + (c + 1) * NAME_SIZE]).rstrip(b'\0').decode()
+        start = columns_at + c * 8 * rows
+        result[name] = view[start:start + 8 * rows].cast('d')
+    return ids, result
+
+
+def main():
+    if len(sys.argv) != 2:
+        print("Usage: python centrality_columns.py Output/<name>.<ungraph|cmty>.columns.bin", file=sys.stderr)
+        return 1
+    ids, columns = read_columns(sys.argv[1])
+    names = list(columns)
+    print("\t".join(['id'] + names))
+    for r in range(len(ids)):
+        print("\t".join([str(ids[r])] + [f"{columns[n][r]:.9f}" for n in names]))
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())
@@ -0,0 +1,595 @@
+#include <stdio.h>
+#include <iostream>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <cmath>
+#include <bitset>
+#include <chrono>
+#include <iomanip>
+#include <thread>
+#include <atomic>
+#include <type_traits>
+#include "csr-graph.h"
+#include "id-map.h"
+#include "graph-cache.h"
+#include "clique-view.h"
+#include "cli-options.h"
+#include "pagerank.h"
+#include "profiler.h"
+#include "result-writer.h"
+#include "brandes.h"
+#include "hypergraph-reduction.h"
+#include "vertex-order.h"
+using namespace std;
+
+/*
+ * All centralities from one load of every dataset.
+ *
+ * The separate programs each reread dataset_init.txt and the graph files.
+ * This driver loads each representation once and computes every selected
+ * measure on it: betweenness, farness, closeness and harmonic come out of the
+ * same per-source traversal (Brandes' forward BFS already yields every level
+ * the distance measures need), degree and PageRank run on the same in-memory
+ * graph. The results go to the usual Output/<Measure>/ files, with the same
+ * values the separate programs write.
+ */
+
+string init[] = {"dataset_init.txt"};
+vector<string> dataset;
+vector<string> graphs;
+vector<string> hypergraphs;
+vector<string> names;
+
+const int MAXN = 4e6;
+const int MAXHE = 3e6;
+CSRGraph graph;
+CliqueView clique;
+vector<char> protein;
+IdMap ids;
+bitset<MAXN + MAXHE> mask;
+// --profile times phases and kernels and writes <output>.profile.json
+Profiler profile;
+// Set for the stored .ungraph: traversals there use the direction-optimizing
+// kernel (see direction-bfs.h)
+bool direction_optimizing = false;
+// --implicit-predecessors: no predecessor lists; the dependency pass finds the
+// predecessors of v among its neighbors as the vertices one level closer
+bool implicit_predecessors = false;
+// Set for the .cmty bipartite graph: traversals there count hops in
+// hypergraph units (see hypergraph-bfs.h)
+bool hypergraph_traversal = false;
+// Set for the .cmty run with --reduce: traversals run over the protein classes
+// of the reduced hypergraph (see hypergraph-reduction.h)
+const HypergraphReduction* reduction = nullptr;
+// --reorder: the renumbering of the loaded graph (see vertex-order.h)
+Reordering reordering;
+
+// --- Measure selection ---
+enum Measure { BETWEENNESS, CLOSENESS, FARNESS, HARMONIC, DEGREE, PAGERANK, NUM_MEASURES };
+const char* const MEASURE_NAMES[] = {"betweenness", "closeness", "farness", "harmonic", "degree", "pagerank"};
+const char* const MEASURE_DIRS[] = {"Betweenness", "Closeness", "Farness", "Harmonic", "Degree", "PageRank"};
+
+// Parses a comma-separated list of measure names (or "all") into `selected`
+bool parse_measures(const string& list, bool selected[]){
+    fill(selected, selected + NUM_MEASURES, false);
+    stringstream in(list);
+    string item;
+    while (getline(in, item, ',')){
+        if (item.empty())
+            continue;
+        if (item == "all"){
+            fill(selected, selected + NUM_MEASURES, true);
+            continue;
+        }
+        int m = 0;
+        while (m < NUM_MEASURES && item != MEASURE_NAMES[m])
+            ++m;
+        if (m == NUM_MEASURES){
+            fprintf(stderr, "ERROR: Unknown measure '%s'\n", item.c_str());
+            return false;
+        }
+        selected[m] = true;
+    }
+    return true;
+}
+
+// --- Per-worker traversal state (see brandes.h), plus the time its thread
+// spent in each kernel ---
+struct Worker : BrandesWorker {
+    Profiler::Tally traversal, progress;
+};
+
+// Distance sums of every source, indexed like `sources`
+struct DistanceSums {
+    vector<double> dist_sum;
+    vector<double> inv_sum;
+    vector<double> reached;
+};
+
+// One source: BFS levels, and with `paths` the shortest-path counts and
+// Brandes' dependency accumulation into w.betweenness. The distance sums count
+// every reached node but the source (only nodes in `mask` with
+// `only_proteins`), dividing bipartite levels by `hop`; the hypergraph
+// traversal reaches only proteins and already counts hypergraph hops.
+template <class Graph>
+void traverse(const Graph& g, typename Graph::Scanner& scan, Worker& w, int source, int hop,
+              bool only_proteins, bool paths, double& dist_sum, double& inv_sum, double& reached){
+    if (paths)
+        w.count_paths(g, scan, source);
+    else
+        w.levels(g, scan, source);
+    if constexpr (is_same<Graph, CSRGraph>::value)
+        if (hypergraph_traversal)
+            hop = 1;
+
+    dist_sum = inv_sum = reached = 0;
+    if (reduction)
+        reduction->distance_sums(source, w.touched, w.level, dist_sum, inv_sum, reached);
+    for (int l: w.touched){
+        if (reduction || l == source || (only_proteins && !mask[l]))
+            continue;
+        dist_sum += (double)w.level[l] / hop;
+        inv_sum += (double)hop / w.level[l];
+        ++reached;
+    }
+
+    if (paths)
+        w.accumulate(g, scan, source, mask);
+}
+
+// Runs traverse() from every source over `threads` workers. Partial
+// betweenness vectors are added to `betweenness` in worker order; the distance
+// sums go straight to their source's slot.
+template <class Graph>
+void run_fused(const Graph& g, const vector<int>& sources, int cnt, int hop, bool only_proteins, bool paths,
+               int threads, vector<double>& betweenness, DistanceSums& sums){
+    vector<Worker> workers(threads);
+    atomic<size_t> next(0), done(0);
+    BrandesMode mode;
+    mode.direction_optimizing = direction_optimizing;
+    mode.hypergraph = hypergraph_traversal;
+    mode.implicit_predecessors = implicit_predecessors;
+    mode.weight = reduction ? &reduction->weight() : nullptr;
+    sums.dist_sum.assign(sources.size(), 0);
+    sums.inv_sum.assign(sources.size(), 0);
+    sums.reached.assign(sources.size(), 0);
+
+    auto work = [&](int id){
+        Worker& w = workers[id];
+        w.init(cnt, mode, paths);
+        typename Graph::Scanner scan(g);
+        bool profiled = profile.enabled();
+        for (size_t k; (k = next++) < sources.size(); ){
+            {
+                Profiler::Timer timer(profiled, w.traversal);
+                traverse(g, scan, w, sources[k], hop, only_proteins, paths, sums.dist_sum[k], sums.inv_sum[k],
+                         sums.reached[k]);
+            }
+            size_t finished = ++done;
+            // Only the calling thread reports progress
+            if (id == 0){
+                Profiler::Timer timer(profiled, w.progress);
+                printf("\b\b\b\b\b\b\b\b\b\b\b\b\b\b\b");
+                printf("%3.6lf%% done", double(finished) / sources.size() * 100);
+            }
+        }
+    };
+
+    vector<thread> pool;
+    for (int t = 1; t < threads; ++t)
+        pool.emplace_back(work, t);
+    work(0);
+    for (auto& t: pool)
+        t.join();
+    if (threads > 1){
+        printf("\b\b\b\b\b\b\b\b\b\b\b\b\b\b\b");
+        printf("%3.6lf%% done", 100.0);
+    }
+    printf("\n");
+
+    for (auto& w: workers){
+        if (paths)
+            for (int i = 0; i < cnt; ++i)
+                betweenness[i] += w.betweenness[i];
+        profile.add("traverse", w.traversal);
+        profile.add("progress", w.progress);
+    }
+}
+
+// run_fused() over the protein classes of `reduction`; every source gets its
+// class's distance sums and every protein in `mask` its class's betweenness.
+void run_reduced(const HypergraphReduction& r, const vector<int>& sources, int hop, bool only_proteins, bool paths,
+                 int threads, vector<double>& betweenness, DistanceSums& sums){
+    vector<int> classes, slot(r.size(), -1);
+    for (int x = 0; x < r.size(); ++x)
+        if (r.protein(x)){
+            slot[x] = classes.size();
+            classes.push_back(x);
+        }
+    vector<double> part(paths ? r.size() : 0, 0);
+    DistanceSums class_sums;
+    run_fused(r.graph(), classes, r.size(), hop, only_proteins, paths, threads, part, class_sums);
+    sums.dist_sum.assign(sources.size(), 0);
+    sums.inv_sum.assign(sources.size(), 0);
+    sums.reached.assign(sources.size(), 0);
+    for (size_t s = 0; s < sources.size(); ++s){
+        int x = slot[r.reduced_index(sources[s])];
+        sums.dist_sum[s] = class_sums.dist_sum[x];
+        sums.inv_sum[s] = class_sums.inv_sum[x];
+        sums.reached[s] = class_sums.reached[x];
+    }
+    if (paths)
+        for (int v = 0; v < (int)betweenness.size(); ++v)
+            if (mask[v])
+                betweenness[v] = part[r.reduced_index(v)];
+}
+
+// --- Results of one representation, written to Output/<Measure>/ ---
+// `memory` and `rss` are the heap and resident-set peaks over loading,
+// building and the compute phase that produced the measure.
+struct Results {
+    vector<double> values[NUM_MEASURES];
+    unsigned long long memory[NUM_MEASURES] = {0};
+    unsigned long long rss[NUM_MEASURES] = {0};
+    double time[NUM_MEASURES] = {0};
+};
+
+// Writes the selected measures of one representation ("ungraph" or "cmty").
+// PageRank rows follow the load order, as pagerank-centrality writes them;
+// the other measures are sorted by original ID. Only nodes in `mask`
+// are written for the hypergraph.
+void write_results(const Results& results, const bool selected[], const string& name, const string& repr,
+                   bool only_proteins){
+    for (int m = 0; m < NUM_MEASURES; ++m){
+        if (!selected[m])
+            continue;
+        ResultWriter out;
+        out.field(results.memory[m]).field(results.time[m]).field(results.rss[m]).end_line().end_line();
+        const vector<double>& values = results.values[m];
+        if (m == PAGERANK){
+            for (int k = 0; k < (int)values.size(); ++k){
+                int j = reordering.index(k);
+                if (!only_proteins || mask[j])
+                    out.row(ids[j], values[j]);
+            }
+        } else {
+            for (int j: ids.sorted_indices())
+                if (!only_proteins || mask[j])
+                    out.row(ids[j], values[j]);
+        }
+        out.save("Output/" + string(MEASURE_DIRS[m]) + "/" + name + "." + repr + "." + MEASURE_NAMES[m] + ".txt");
+    }
+}
+
+// Writes the selected measures of one representation as columns of
+// Output/<name>.<repr>.columns.bin (see result-writer.h), one row per node
+// sorted by original ID; only nodes in `mask` for the hypergraph.
+void write_columnar(const Results& results, const bool selected[], const string& name, const string& repr,
+                    bool only_proteins){
+    vector<int> rows, row_ids;
+    for (int j: ids.sorted_indices())
+        if (!only_proteins || mask[j]){
+            rows.push_back(j);
+            row_ids.push_back(ids[j]);
+        }
+    vector<ResultColumn> columns;
+    for (int m = 0; m < NUM_MEASURES; ++m){
+        if (!selected[m])
+            continue;
+        ResultColumn column{MEASURE_NAMES[m], vector<double>(rows.size())};
+        for (size_t r = 0; r < rows.size(); ++r)
+            column.values[r] = results.values[m][rows[r]];
+        columns.push_back(move(column));
+    }
+    string path = "Output/" + name + "." + repr + ".columns.bin";
+    if (!write_columns(path, row_ids, columns))
+        fprintf(stderr, "WARNING: Could not write %s\n", path.c_str());
+}
+
+// Records the compute phase just closed as the memory of measure m: its
+// peaks, or those of loading and building if they were higher.
+void charge_phase(unsigned long long base_heap, unsigned long long base_rss, int m, Results& results){
+    const MemoryPhases::Phase& phase = profile.memory.list().back();
+    results.memory[m] = max(base_heap, phase.heap);
+    results.rss[m] = max(base_rss, phase.rss);
+}
+
+// Computes every selected measure on the representation currently loaded
+// (`clique` when `implicit`, else `graph`). `load_time` is charged to every
+// measure, like the separate programs charge their own load. Each group of
+// measures runs in its own compute phase of `profile`.
+template <class Graph>
+void compute_all(const Graph& g, bool implicit, const vector<int>& sources, int cnt, int hop, bool only_proteins,
+                 int normalizer, int hyperedge_count, const bool selected[], int threads, pageRank::Solver solver,
+                 double load_time, Results& results){
+    profile.end();
+    unsigned long long base_heap = profile.memory.heap_peak(), base_rss = profile.memory.rss_peak();
+    bool distances = selected[CLOSENESS] || selected[FARNESS] || selected[HARMONIC];
+
+    if (selected[BETWEENNESS] || distances){
+        profile.begin("traverse");
+        auto begin = chrono::high_resolution_clock::now();
+        vector<double>& betweenness = results.values[BETWEENNESS];
+        betweenness.assign(selected[BETWEENNESS] ? cnt : 0, 0);
+        DistanceSums sums;
+        {
+            Profiler::Scope scope(profile, profile.kernel("fused"));
+            if (reduction)
+                run_reduced(*reduction, sources, hop, only_proteins, selected[BETWEENNESS], threads, betweenness,
+                            sums);
+            else
+                run_fused(g, sources, cnt, hop, only_proteins, selected[BETWEENNESS], threads, betweenness, sums);
+        }
+        vector<double>& farness = results.values[FARNESS];
+        vector<double>& closeness = results.values[CLOSENESS];
+        vector<double>& harmonic = results.values[HARMONIC];
+        farness.assign(cnt, 0);
+        closeness.assign(cnt, 0);
+        harmonic.assign(cnt, 0);
+        // Farness is normalized by the number of reachable nodes in the
+        // component, harmonic by the total number of nodes in the graph
+        for (size_t s = 0; s < sources.size(); ++s){
+            int k = sources[s];
+            farness[k] = (sums.reached[s] > 0) ? sums.dist_sum[s] / sums.reached[s] : 0;
+            closeness[k] = (farness[k] > 0) ? 1.0 / farness[k] : 0;
+            harmonic[k] = (normalizer > 1) ? sums.inv_sum[s] / (normalizer - 1) : 0;
+        }
+        double time = load_time + chrono::duration_cast<chrono::duration<double>>(
+                                      chrono::high_resolution_clock::now() - begin).count();
+        profile.end();
+        for (int m: {BETWEENNESS, CLOSENESS, FARNESS, HARMONIC}){
+            charge_phase(base_heap, base_rss, m, results);
+            results.time[m] = time;
+        }
+        printf("Traversal from %zu sources: %lf Seconds\n", sources.size(), time - load_time);
+    }
+
+    if (selected[DEGREE]){
+        profile.begin("degree");
+        auto begin = chrono::high_resolution_clock::now();
+        vector<double>& degree = results.values[DEGREE];
+        degree.assign(cnt, 0);
+        {
+            Profiler::Scope scope(profile, profile.kernel("degree"));
+            for (int j = 0; j < cnt; ++j)
+                degree[j] = g.degree(j);
+        }
+        profile.end();
+        charge_phase(base_heap, base_rss, DEGREE, results);
+        results.time[DEGREE] = load_time + chrono::duration_cast<chrono::duration<double>>(
+                                               chrono::high_resolution_clock::now() - begin).count();
+    }
+
+    if (selected[PAGERANK]){
+        profile.begin("pagerank");
+        auto begin = chrono::high_resolution_clock::now();
+        pageRank::Table calculator;
+        calculator.set_undirected(true);
+        calculator.set_hypergraph(!implicit && only_proteins);
+        calculator.set_solver(solver);
+        if constexpr (is_same<Graph, CliqueView>::value)
+            calculator.load_clique(g, ids);
+        else
+            calculator.load_graph(g, ids, hyperedge_count);
+        {
+            Profiler::Scope scope(profile, profile.kernel("pagerank"));
+            calculator.calculate_pagerank();
+        }
+        results.values[PAGERANK] = calculator.get_pagerank_vector();
+        profile.end();
+        charge_phase(base_heap, base_rss, PAGERANK, results);
+        results.time[PAGERANK] = load_time + chrono::duration_cast<chrono::duration<double>>(
+                                                 chrono::high_resolution_clock::now() - begin).count();
+        printf("PageRank: %zu iterations, %lf Seconds\n", calculator.get_residuals().size(),
+               results.time[PAGERANK] - load_time);
+    }
+}
+
+// One copy of the run's profile next to each selected measure's output file
+void write_profiles(const bool selected[], const string& name, const string& repr){
+    for (int m = 0; m < NUM_MEASURES; ++m)
+        if (selected[m])
+            profile.write_json("Output/" + string(MEASURE_DIRS[m]) + "/" + name + "." + repr + "." + MEASURE_NAMES[m] +
+                               ".profile.json", "all", name, repr);
+}
+
+int main(int argc, char* argv[]){
+    ios_base::sync_with_stdio(false);
+    Options opts(argc, argv);
+    if (!opts.known({"bipartite-bfs", "clique-view", "columnar", "implicit-predecessors", "measures", "no-cache",
+                     "profile", "reduce", "reorder", "solver", "threads", "top-down"}))
+        return 1;
+    // --measures=betweenness,closeness,farness,harmonic,degree,pagerank (default all)
+    bool selected[NUM_MEASURES];
+    if (!parse_measures(opts.get("measures", "all"), selected))
+        return 1;
+    // --threads=N spreads traversal sources over N workers (0 = all cores)
+    int threads = opts.get_int("threads", 1);
+    if (threads <= 0)
+        threads = max(1u, thread::hardware_concurrency());
+    // Parsed datasets are snapshotted to <input>.csr unless --no-cache is given
+    bool use_cache = !opts.has("no-cache");
+    // --clique-view computes the graph results from the hypergraph's implicit
+    // clique expansion instead of reading the materialized .graph file
+    bool clique_view = opts.has("clique-view");
+    // --top-down keeps the queue-based traversal on the .ungraph instead of
+    // the direction-optimizing kernel
+    bool top_down = opts.has("top-down");
+    // --bipartite-bfs runs the generic BFS over the .cmty bipartite graph
+    // instead of the hypergraph traversal
+    bool bipartite_bfs = opts.has("bipartite-bfs");
+    // --reduce collapses duplicate hyperedges and twin proteins of the .cmty
+    // hypergraph for the traversal-based measures (degree and PageRank run on
+    // the full hypergraph)
+    bool reduce = opts.has("reduce");
+    // --reorder=rcm|gorder|degree renumbers every loaded graph for cache
+    // locality (see vertex-order.h); results keep their original IDs
+    VertexOrder reorder = VertexOrder::NONE;
+    if (opts.has("reorder") && !parse_vertex_order(opts.get("reorder"), reorder)){
+        fprintf(stderr, "ERROR: Unknown vertex order '%s'\n", opts.get("reorder").c_str());
+        return 1;
+    }
+    if (reduce && bipartite_bfs){
+        printf("INFO: --reduce runs on the hypergraph traversal; ignoring it with --bipartite-bfs.\n");
+        reduce = false;
+    }
+    // --columnar also writes every measure of a representation as one
+    // binary column file, Output/<name>.<ungraph|cmty>.columns.bin
+    bool columnar = opts.has("columnar");
+    // --implicit-predecessors drops the per-vertex predecessor lists, so each
+    // worker keeps O(V) scratch; betweenness rescans neighbors instead
+    implicit_predecessors = opts.has("implicit-predecessors");
+    if (opts.has("profile"))
+        profile.enable();
+    // --solver=jacobi|gauss-seidel|aitken|adaptive picks the PageRank iteration scheme
+    pageRank::Solver solver = pageRank::JACOBI;
+    if (opts.has("solver") && !pageRank::parse_solver(opts.get("solver"), solver)){
+        fprintf(stderr, "ERROR: Unknown solver '%s'\n", opts.get("solver").c_str());
+        return 1;
+    }
+
+    printf("INFO: This program saves results to the following directories:\n");
+    for (int m = 0; m < NUM_MEASURES; ++m)
+        if (selected[m])
+            printf("      - Output/%s/\n", MEASURE_DIRS[m]);
+    printf("INFO: Please ensure these directories exist before running.\n");
+
+    ifstream fin;
+    for (auto& s: init){
+        fin.open(s);
+        if (!fin.is_open()){
+            fprintf(stderr, "ERROR: Could not open initialization file: %s\n", s.c_str());
+            return 1;
+        }
+        string line;
+        while (getline(fin, line)){
+            if (line.empty())
+                continue;
+            dataset.push_back(line);
+            getline(fin, line); graphs.push_back(line);
+            getline(fin, line); hypergraphs.push_back(line);
+            getline(fin, line); names.push_back(line);
+        }
+        fin.close();
+    }
+
+    printf("Running with %d thread(s).\n", threads);
+    printf("%s\n", string(80, '=').c_str());
+    for (size_t i = 0; i < dataset.size(); ++i){
+        printf("Dataset #%zu (%s):\n\n", i+1, dataset[i].c_str());
+
+        // ===================================================================
+        //  Part 1: Standard Graph Representation
+        // ===================================================================
+        {
+            profile.reset();
+            const MemoryPhases& phases = profile.memory;
+            auto begin = chrono::high_resolution_clock::now();
+            profile.begin("load");
+            if (clique_view)
+                load_clique_view(hypergraphs[i], MAXN, use_cache, ids, clique);
+            else
+                load_dataset(graphs[i], -1, use_cache, ids, graph, protein);
+            double load_time = chrono::duration_cast<chrono::duration<double>>(
+                                   chrono::high_resolution_clock::now() - begin).count();
+            profile.begin("build");
+            // The clique view is built from the hypergraph and keeps its numbering
+            reordering = clique_view ? Reordering() : reorder_dataset(reorder, ids, graph, protein);
+            printf("%s", reordering.report().c_str());
+            int cnt = ids.size();
+            // Every node of the plain graph is a protein
+            mask.set();
+            direction_optimizing = !clique_view && !top_down;
+            hypergraph_traversal = false;
+            vector<int> sources(cnt);
+            for (int k = 0; k < cnt; ++k)
+                sources[k] = k;
+
+            printf("For graph representation (loaded in %lf Seconds):\n", load_time);
+            Results results;
+            if (clique_view)
+                compute_all(clique, true, sources, cnt, 1, false, cnt, 0, selected, threads, solver, load_time,
+                            results);
+            else
+                compute_all(graph, false, sources, cnt, 1, false, cnt, 0, selected, threads, solver, load_time,
+                            results);
+            profile.begin("output");
+            write_results(results, selected, names[i], "ungraph", false);
+            if (columnar)
+                write_columnar(results, selected, names[i], "ungraph", false);
+            profile.end();
+            printf("Memory by phase:\n%s\n", phases.report().c_str());
+            if (profile.enabled())
+                write_profiles(selected, names[i], "ungraph");
+            // Release the graph so the hypergraph run is measured on its own
+            clique = CliqueView();
+            graph = CSRGraph();
+            ids = IdMap();
+            protein = vector<char>();
+            reordering = Reordering();
+        }
+
+        // ===================================================================
+        //  Part 2: Hypergraph Representation
+        // ===================================================================
+        {
+            profile.reset();
+            const MemoryPhases& phases = profile.memory;
+            auto begin = chrono::high_resolution_clock::now();
+            profile.begin("load");
+            int hyperedge_count = load_dataset(hypergraphs[i], MAXN, use_cache, ids, graph, protein);
+            double load_time = chrono::duration_cast<chrono::duration<double>>(
+                                   chrono::high_resolution_clock::now() - begin).count();
+            profile.begin("build");
+            reordering = reorder_dataset(reorder, ids, graph, protein);
+            printf("%s", reordering.report().c_str());
+            int cnt = ids.size();
+            mask.reset();
+            for (int k = 0; k < cnt; ++k)
+                if (protein[k])
+                    mask.set(k);
+            // The bipartite graph has no dense cliques for bottom-up steps to skip
+            direction_optimizing = false;
+            hypergraph_traversal = !bipartite_bfs;
+            // Only original protein nodes act as sources
+            vector<int> sources;
+            for (int k = 0; k < cnt; ++k)
+                if (mask[k])
+                    sources.push_back(k);
+
+            // The distance between two protein nodes in the bipartite graph is
+            // twice the hypergraph distance, hence hop = 2
+            printf("For hypergraph representation (loaded in %lf Seconds):\n", load_time);
+            Results results;
+            HypergraphReduction reduced;
+            if (reduce){
+                reduced.build(graph, protein);
+                reduction = &reduced;
+                printf("Reduced hypergraph: %d protein classes for %zu proteins, %d distinct hyperedges of %d, "
+                       "%lld incidences removed\n", reduced.num_protein_classes(), sources.size(),
+                       reduced.num_hyperedge_classes(), hyperedge_count, reduced.arcs_removed());
+            }
+            compute_all(graph, false, sources, cnt, 2, true, cnt - hyperedge_count, hyperedge_count, selected, threads,
+                        solver, load_time, results);
+            reduction = nullptr;
+            profile.begin("output");
+            write_results(results, selected, names[i], "cmty", true);
+            if (columnar)
+                write_columnar(results, selected, names[i], "cmty", true);
+            profile.end();
+            printf("Memory by phase:\n%s", phases.report().c_str());
+            if (profile.enabled())
+                write_profiles(selected, names[i], "cmty");
+            graph = CSRGraph();
+            ids = IdMap();
+            protein = vector<char>();
+            reordering = Reordering();
+        }
+
+        printf("%s\n", string(80, '=').c_str());
+    }
+
+    return 0;
+}
@@ -1,15 +1,25 @@
 #include <stdio.h>
 #include <fstream>
-#include <sstream>
 #include <string>
 #include <vector>
-#include <stack>
 #include <queue>
-#include <map>
 #include <cmath>
 #include <bitset>
 #include <chrono>
 #include <iomanip>
+#include <thread>
+#include <atomic>
+#include "csr-graph.h"
+#include "id-map.h"
+#include "graph-cache.h"
+#include "clique-view.h"
+#include "cli-options.h"
+#include "graph-updates.h"
+#include "profiler.h"
+#include "result-writer.h"
+#include "brandes.h"
+#include "hypergraph-reduction.h"
+#include "vertex-order.h"
 using namespace std;
 // #define endl '\n'
 
@@ -22,103 +32,417 @@ vector<string> names;
 const int MAXN = 4e6;
 const int MAXHE = 3e6;
 const double epsilon = 1e-9;
-vector<int> graph[MAXN + MAXHE];
-vector<int> predecessor[MAXN + MAXHE];
-vector<int> level;
-vector<double> sigma;
-map<int, int> idx_to_node;
-map<int, int> node_to_idx;
+CSRGraph graph;
+CliqueView clique;
+vector<char> protein;
+IdMap ids;
 vector<double> betweenness;
-bitset<MAXN + MAXHE> visited;
 bitset<MAXN + MAXHE> mask;
+// --profile times phases and kernels and writes <output>.profile.json
+Profiler profile;
+// Set for the stored .ungraph: full Brandes traversals there use the
+// direction-optimizing forward phase
+bool direction_optimizing = false;
+// --implicit-predecessors: no predecessor lists; the backward phase finds the
+// predecessors of v among its neighbors as the vertices one level closer
+bool implicit_predecessors = false;
+// Set for the .cmty bipartite graph: full Brandes traversals there count hops
+// in hypergraph units with HypergraphBFS (see hypergraph-bfs.h)
+bool hypergraph_traversal = false;
+// Set while Brandes runs on a reduced hypergraph: the number of proteins or
+// hyperedges behind every node (see hypergraph-reduction.h)
+const vector<double>* class_weight = nullptr;
+
+// --- Per-worker Brandes state (see brandes.h), plus the time its thread spent
+// in each pass ---
+struct Worker : BrandesWorker {
+    Profiler::Tally forward, backward, progress;
+};
+
+// The traversal the graph being processed calls for
+BrandesMode brandes_mode(){
+    BrandesMode mode;
+    mode.direction_optimizing = direction_optimizing;
+    mode.hypergraph = hypergraph_traversal;
+    mode.implicit_predecessors = implicit_predecessors;
+    mode.weight = class_weight;
+    return mode;
+}
 
-template<class K, class V>
-unsigned long long getMemoryUsage(const map<K, V>& m) {
-  // Node structure estimation for Red-Black trees
-  // With the key and the value, 2 child pointers, 1 parent pointer, and 1 color bit
-  unsigned long long nodeSize = sizeof(K) + sizeof(V) + 3 * sizeof(void*) + sizeof(bool);
-  // Administrative overhead assuming 3 pointers + 1 size_t
-  unsigned long long adminSize = 3 * sizeof(void*) + sizeof(size_t);
-  unsigned long long totalSize = adminSize + m.size() * nodeSize;
-
-  return totalSize;
+// Brandes Algorithm
+template <class Graph>
+void solve(const Graph& g, typename Graph::Scanner& scan, Worker& w, int source){
+    bool profiled = profile.enabled();
+    {
+        Profiler::Timer timer(profiled, w.forward);
+        w.count_paths(g, scan, source);
+    }
+    Profiler::Timer timer(profiled, w.backward);
+    w.accumulate(g, scan, source, mask);
 }
 
-unsigned long long getMemoryUsage2(vector<int> g[], int cnt) {
-  unsigned long long totalSize = 0;
-  for (int i = 0; i < cnt; ++i)
-    totalSize += g[i].size();
-  totalSize *= sizeof(int);
-  return totalSize;
+// Runs solve() from every source, handing sources out to `threads` workers.
+// Each worker accumulates into its own betweenness vector; the partial vectors
+// are added to `result` in worker order once every source is done. With
+// `record`, the BFS levels of every source are kept for incremental updates.
+template <class Graph>
+void run_brandes(const Graph& g, const vector<int>& sources, int cnt, int threads, vector<double>& result,
+                 SourceDistances* record = nullptr){
+    vector<Worker> workers(threads);
+    atomic<size_t> next(0), done(0);
+    if (record)
+        record->resize(cnt);
+
+    auto work = [&](int id){
+        Worker& w = workers[id];
+        w.init(cnt, brandes_mode());
+        typename Graph::Scanner scan(g);
+        for (size_t k; (k = next++) < sources.size(); ){
+            solve(g, scan, w, sources[k]);
+            if (record){
+                // Recorded levels are bipartite, so hypergraph hops count twice
+                int scale = hypergraph_traversal ? 2 : 1;
+                record->begin(sources[k], cnt);
+                for (int v: w.touched)
+                    record->set(sources[k], v, scale * w.level[v]);
+                for (int e: w.opened)
+                    record->set(sources[k], e, 2 * w.level[e] + 1);
+            }
+            size_t finished = ++done;
+            // Only the calling thread reports progress
+            if (id == 0){
+                Profiler::Timer timer(profile.enabled(), w.progress);
+                printf("\b\b\b\b\b\b\b\b\b\b\b\b\b\b\b");
+                printf("%3.6lf%% done", double(finished)/sources.size()*100);
+            }
+        }
+    };
+
+    vector<thread> pool;
+    for (int t = 1; t < threads; ++t)
+        pool.emplace_back(work, t);
+    work(0);
+    for (auto& t: pool)
+        t.join();
+    if (threads > 1){
+        printf("\b\b\b\b\b\b\b\b\b\b\b\b\b\b\b");
+        printf("%3.6lf%% done", 100.0);
+    }
+
+    for (auto& w: workers){
+        for (int i = 0; i < cnt; ++i)
+            result[i] += w.betweenness[i];
+        profile.add("forward", w.forward);
+        profile.add("backward", w.backward);
+        profile.add("progress", w.progress);
+    }
 }
 
-template<class T>
-unsigned long long getMemoryUsage3(const vector<T>& v, unsigned long long cnt) {
-  return cnt * sizeof(v[0]);
+// --- Approximate betweenness (Riondato-Kornaropoulos shortest-path sampling) ---
+// Each sample picks a random pair of distinct sources (u, v) and one shortest
+// u-v path uniformly at random, and credits its interior proteins. With
+// r = (c / eps^2) * (floor(log2(VD - 2)) + 1 + ln(1 / delta)) samples, where VD
+// bounds the number of vertices on a shortest path, every normalized estimate
+// is within eps of the exact value with probability at least 1 - delta.
+struct ApproxConfig {
+    bool enabled = false;
+    double epsilon = 0.01;
+    double delta = 0.1;
+    unsigned long long seed = 1;
+    // Filled in for each run: the bound actually guaranteed (0 when the run
+    // fell back to exact Brandes) and the number of paths sampled
+    double bound_epsilon = 0;
+    double bound_delta = 0;
+    long long samples = 0;
+} approx;
+
+// splitmix64; each sample seeds its own generator, so the drawn pairs and
+// paths do not depend on which worker takes the sample
+struct SplitMix64 {
+    unsigned long long state;
+    unsigned long long next() {
+        unsigned long long z = (state += 0x9E3779B97F4A7C15ull);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+    unsigned long long below(unsigned long long n) { return next() % n; }
+    double uniform() { return (next() >> 11) * (1.0 / 9007199254740992.0); }
+};
+
+// Upper bound on the proteins on any shortest path: one BFS per connected
+// component, 2 * eccentricity + 1 (bipartite levels are divided by `hop`).
+template <class Graph>
+int vertex_diameter(const Graph& g, const vector<int>& sources, int cnt, int hop){
+    typename Graph::Scanner scan(g);
+    vector<int> level(cnt, -1);
+    int vd = 1;
+    for (int s: sources){
+        if (level[s] >= 0)
+            continue;
+        queue<int> Q;
+        Q.push(s);
+        level[s] = 0;
+        int ecc = 0;
+        scan.reset();
+        while(!Q.empty()){
+            int v = Q.front();
+            Q.pop();
+            if (mask[v])
+                ecc = max(ecc, level[v] / hop);
+            scan.expand(v, [&](int u){
+                if (level[u] < 0){
+                    level[u] = level[v] + 1;
+                    Q.push(u);
+                }
+            });
+        }
+        vd = max(vd, 2 * ecc + 1);
+    }
+    return vd;
 }
 
-// Brandes Algorithm
-unsigned long long solve(int source, int cnt){
-    stack<int> S;
-    level.resize(cnt);
-    queue<int> Q;
-    sigma.assign(cnt, 0);
-    for (int i = 0; i < cnt; ++i)
-        predecessor[i].clear();
-    visited.reset();
-    unsigned long long mem = 0;
-
-    sigma[source] = 1;
-    level[source] = 0;
-    Q.push(source);
-    visited[source] = true;
-    while(!Q.empty()){
-        mem = max(mem, (unsigned long long)Q.size());
-        int current_vertex = Q.front();
-        Q.pop();
-        S.push(current_vertex);
-        for(auto node: graph[current_vertex]){
-            if(!visited[node]) {
-                Q.push(node);
-                level[node] = level[current_vertex] +1;
+// Runs `samples` path samples over `threads` workers and scales the counts to
+// the exact output's units (each unordered pair of sources counted once).
+template <class Graph>
+void run_sampling(const Graph& g, const vector<int>& sources, int cnt, long long samples, int threads){
+    vector<Worker> workers(threads);
+    atomic<long long> next(0), done(0);
+    // Sampled searches stop early, so they always take the generic kernel
+    BrandesMode mode;
+    mode.implicit_predecessors = implicit_predecessors;
+    unsigned long long n = sources.size();
+
+    auto work = [&](int id){
+        Worker& w = workers[id];
+        w.init(cnt, mode);
+        typename Graph::Scanner scan(g);
+        for (long long k; (k = next++) < samples; ){
+            SplitMix64 seeder{approx.seed ^ ((unsigned long long)k * 0xD1B54A32D192ED03ull)};
+            SplitMix64 rng{seeder.next()};
+            int u = sources[rng.below(n)], v;
+            do v = sources[rng.below(n)]; while (v == u);
+
+            Profiler::Timer timer(profile.enabled(), w.forward);
+            w.count_paths(g, scan, u, v);
+            // Walk back from v, taking each predecessor p of x with probability sigma[p] / sigma[x]
+            for (int x = v; w.visited.marked(v); ){
+                double r = rng.uniform() * w.sigma[x];
+                int p;
+                if (implicit_predecessors){
+                    // The search stopped early, so only marked neighbors have
+                    // valid levels. Neighbor order differs from predecessor
+                    // order, so the sampled paths differ from the default mode.
+                    p = -1;
+                    scan.neighbors(x, [&](int z){
+                        if (r < 0 || !w.visited.marked(z) || w.level[z] != w.level[x] - 1)
+                            return;
+                        p = z;      // the last predecessor if rounding keeps r >= 0
+                        r -= w.sigma[z];
+                    });
+                } else {
+                    p = w.predecessor[x].back();
+                    for (int z: w.predecessor[x]){
+                        if (r < w.sigma[z]){
+                            p = z;
+                            break;
+                        }
+                        r -= w.sigma[z];
+                    }
+                }
+                if (p == u)
+                    break;
+                if (mask[p])
+                    w.betweenness[p] += 1;
+                x = p;
             }
-            visited[node] = true;
-            // Update sigma value of node if path through current_vertex was shortest
-            if(level[node] == level[current_vertex]+1){
-                sigma[node] = sigma[node] + sigma[current_vertex];
-                predecessor[node].push_back(current_vertex);
+
+            long long finished = ++done;
+            if (id == 0 && finished % 64 == 0){
+                printf("\b\b\b\b\b\b\b\b\b\b\b\b\b\b\b");
+                printf("%3.6lf%% done", double(finished)/samples*100);
             }
         }
+    };
+
+    vector<thread> pool;
+    for (int t = 1; t < threads; ++t)
+        pool.emplace_back(work, t);
+    work(0);
+    for (auto& t: pool)
+        t.join();
+    printf("\b\b\b\b\b\b\b\b\b\b\b\b\b\b\b");
+    printf("%3.6lf%% done", 100.0);
+
+    double scale = samples > 0 ? (double)n * (n - 1) / 2 / samples : 0;
+    for (auto& w: workers){
+        for (int i = 0; i < cnt; ++i)
+            betweenness[i] += w.betweenness[i];
+        profile.add("sample", w.forward);
     }
-    mem *= sizeof(int);
-    mem += S.size() * sizeof(int);
-
-    vector<double> delta(cnt, 0);
-    // Pop elements out of the stack, starting from terminal node
-    // work backward frontier b frontier, computing delta values
-    while(!S.empty()) {
-        int v = S.top();
-        S.pop();
-        for(auto& u: predecessor[v])
-            delta[u] += (sigma[u]/sigma[v]) * (mask[v]+delta[v]);
-        if(v != source)
-            betweenness[v] += delta[v]/2;
+    for (int i = 0; i < cnt; ++i)
+        betweenness[i] *= scale;
+}
+
+// Exact Brandes, or path sampling with the sample size derived from
+// approx.epsilon / approx.delta when --approx is given.
+template <class Graph>
+void run_betweenness(const Graph& g, const vector<int>& sources, int cnt, int hop, int threads,
+                     SourceDistances* record = nullptr){
+    approx.bound_epsilon = approx.bound_delta = 0;
+    approx.samples = 0;
+    if (!approx.enabled){
+        Profiler::Scope scope(profile, profile.kernel("brandes"));
+        run_brandes(g, sources, cnt, threads, betweenness, record);
+        return;
+    }
+    int vd;
+    {
+        Profiler::Scope scope(profile, profile.kernel("vertex_diameter"));
+        vd = vertex_diameter(g, sources, cnt, hop);
     }
+    double c = 0.5;
+    double vc = (vd > 2 ? floor(log2(vd - 2)) : 0) + 1;
+    long long samples = (long long)ceil(c / (approx.epsilon * approx.epsilon) * (vc + log(1 / approx.delta)));
+    // One sample costs about one traversal, so small graphs are cheaper exactly
+    if (samples >= (long long)sources.size()){
+        printf("Sampling would need %lld traversals for %zu sources; computing exact betweenness.\n",
+               samples, sources.size());
+        Profiler::Scope scope(profile, profile.kernel("brandes"));
+        run_brandes(g, sources, cnt, threads, betweenness, record);
+        return;
+    }
+    approx.bound_epsilon = approx.epsilon;
+    approx.bound_delta = approx.delta;
+    approx.samples = samples;
+    printf("Sampling %lld shortest paths (vertex diameter bound %d).\n", samples, vd);
+    Profiler::Scope scope(profile, profile.kernel("sampling"));
+    run_sampling(g, sources, cnt, samples, threads);
+}
 
-    mem += getMemoryUsage3(level, cnt);
-    mem += getMemoryUsage3(sigma, cnt);
-    mem += getMemoryUsage2(predecessor, cnt);
-    mem += getMemoryUsage3(delta, cnt);
-    return mem;
+// Exact betweenness of every protein in `mask` from one Brandes traversal per
+// protein class of the reduced hypergraph; members share their class's value.
+void run_reduced(const HypergraphReduction& reduction, int cnt, int threads){
+    vector<int> classes;
+    for (int x = 0; x < reduction.size(); ++x)
+        if (reduction.protein(x))
+            classes.push_back(x);
+    vector<double> part(reduction.size(), 0);
+    class_weight = &reduction.weight();
+    {
+        Profiler::Scope scope(profile, profile.kernel("brandes"));
+        run_brandes(reduction.graph(), classes, reduction.size(), threads, part);
+    }
+    class_weight = nullptr;
+    for (int v = 0; v < cnt; ++v)
+        if (mask[v])
+            betweenness[v] = part[reduction.reduced_index(v)];
+}
+
+// Applies `changes` to `g` and brings `betweenness` up to date by rerunning
+// Brandes only from the sources whose shortest-path DAG changes: their old
+// contributions are taken out on the old graph, the new ones added on the
+// updated graph. That costs two traversals per affected source, so when half
+// the sources or more are affected everything is recomputed instead. New
+// protein nodes (set in `mask`) join `sources`. Returns the number of sources
+// rerun.
+size_t update_betweenness(CSRGraph& g, const GraphChanges& changes, vector<int>& sources, SourceDistances& dist,
+                          int threads){
+    vector<int> affected;
+    for (int s: sources)
+        if (dist.affected(s, changes))
+            affected.push_back(s);
+    int old_cnt = g.size();
+    bool full = 2 * affected.size() >= sources.size();
+    if (full){
+        affected = sources;
+        betweenness.assign(old_cnt, 0);
+    } else {
+        vector<double> part(old_cnt, 0);
+        run_brandes(g, affected, old_cnt, threads, part);
+        for (int i = 0; i < old_cnt; ++i)
+            betweenness[i] -= part[i];
+    }
+
+    apply_changes(g, changes);
+    int cnt = g.size();
+    betweenness.resize(cnt, 0);
+    for (int v = old_cnt; v < cnt; ++v){
+        if (mask[v]){
+            sources.push_back(v);
+            affected.push_back(v);
+        }
+    }
+    vector<double> part(cnt, 0);
+    run_brandes(g, affected, cnt, threads, part, &dist);
+    for (int i = 0; i < cnt; ++i)
+        betweenness[i] += part[i];
+    return affected.size();
 }
 
-int main(){
+int main(int argc, char* argv[]){
     ios_base::sync_with_stdio(false);
+    Options opts(argc, argv);
+    if (!opts.known({"approx", "bipartite-bfs", "clique-view", "delta", "epsilon", "implicit-predecessors",
+                     "no-cache", "profile", "reduce", "reorder", "seed", "threads", "top-down", "updates"}))
+        return 1;
+    // --threads=N spreads Brandes sources over N workers (0 = all cores)
+    int threads = opts.get_int("threads", 1);
+    if (threads <= 0)
+        threads = max(1u, thread::hardware_concurrency());
+    // Parsed datasets are snapshotted to <input>.csr unless --no-cache is given
+    bool use_cache = !opts.has("no-cache");
+    // --clique-view computes the graph results from the hypergraph's implicit
+    // clique expansion instead of reading the materialized .graph file
+    bool clique_view = opts.has("clique-view");
+    // --top-down keeps the queue-based forward phase on the .ungraph instead
+    // of the direction-optimizing kernel
+    bool top_down = opts.has("top-down");
+    // --bipartite-bfs runs the generic BFS over the .cmty bipartite graph
+    // instead of the hypergraph traversal
+    bool bipartite_bfs = opts.has("bipartite-bfs");
+    // --reduce collapses duplicate hyperedges and twin proteins of the .cmty
+    // hypergraph and runs one traversal per protein class
+    bool reduce = opts.has("reduce");
+    // --reorder=rcm|gorder|degree renumbers every loaded graph for cache
+    // locality (see vertex-order.h); results keep their original IDs
+    VertexOrder reorder = VertexOrder::NONE;
+    if (opts.has("reorder") && !parse_vertex_order(opts.get("reorder"), reorder)){
+        fprintf(stderr, "ERROR: Unknown vertex order '%s'\n", opts.get("reorder").c_str());
+        return 1;
+    }
+    // --implicit-predecessors drops the per-vertex predecessor lists, so each
+    // worker keeps O(V) scratch; the backward phase rescans neighbors instead
+    implicit_predecessors = opts.has("implicit-predecessors");
+    // --approx samples shortest paths until --epsilon / --delta are guaranteed
+    approx.enabled = opts.has("approx");
+    approx.epsilon = opts.get_double("epsilon", approx.epsilon);
+    approx.delta = opts.get_double("delta", approx.delta);
+    approx.seed = opts.get_int("seed", approx.seed);
+    if (opts.has("profile"))
+        profile.enable();
+    // --updates=<file> applies a batch of hyperedge insertions/deletions after
+    // the first run and reruns only the sources whose shortest paths change.
+    // Path counts change far more often than distances: a CORUM batch that
+    // touches the giant component reaches the DAG of nearly every source, so
+    // it reruns them all and the gain is limited to small components.
+    HyperedgeBatch batch;
+    if (opts.has("updates") && !read_hyperedge_batch(opts.get("updates"), batch))
+        return 1;
+    bool dynamic = !batch.empty() && !approx.enabled;
+    if (!batch.empty() && approx.enabled)
+        printf("Incremental updates need exact betweenness; ignoring --updates with --approx.\n");
+    if (dynamic && clique_view)
+        printf("The clique view has no stored graph to update; --updates only applies to the hypergraph.\n");
+    if (reduce && (dynamic || approx.enabled || bipartite_bfs)){
+        printf("The reduction needs exact Brandes over the hypergraph traversal; ignoring --reduce with "
+               "--updates, --approx or --bipartite-bfs.\n");
+        reduce = false;
+    }
     // cin.tie(NULL);
     // cin.exceptions(cin.failbit);
 
     ifstream fin;
-    ofstream fout;
     for (auto& s: init){
         fin.open(s);
         string line;
@@ -136,85 +460,112 @@ int main(){
         fin.close();
     }
 
+    printf("Running Brandes with %d thread(s).\n", threads);
     printf("%s\n", string(80, '=').c_str());
     for (int i = 0; i < dataset.size(); ++i){
         printf("Dataset #%d (%s):\n\n", i+1, dataset[i].c_str());
-        int nodes, edges;
 
-        unsigned long long memory = 0;
+        profile.reset();
+        const MemoryPhases& phases = profile.memory;
         auto begin = chrono::high_resolution_clock::now();
 
         // Graph
-        fin.open(graphs[i]);
-
-        fin>>nodes>>edges;
-
-        for (int i = 0; i < MAXN + MAXHE; ++i)
-        graph[i].clear();
-        idx_to_node.clear();
-        node_to_idx.clear();
-        betweenness.assign(MAXN + MAXHE, 0);
-
-        int u, v, cnt = 0;
-        mask.reset();
-        while(fin>>u>>v){
-            if(!node_to_idx.count(u)){
-                idx_to_node[cnt] = u;
-                node_to_idx[u] = cnt++;
-            }
-            u = node_to_idx[u];
-            if(!node_to_idx.count(v)){
-                idx_to_node[cnt] = v;
-                node_to_idx[v] = cnt++;
-            }
-            v = node_to_idx[v];
-            mask[u] = mask[v] = true;
-            graph[u].push_back(v);
-            graph[v].push_back(u);
-        }
-
-        unsigned long long mem = 0;
-        int j = 0;
-        for (int i = 0; i < cnt; ++i){
-            double temp = double(++j)/cnt;
-
-            printf("\b\b\b\b\b\b\b\b\b\b\b\b\b\b\b");
-            printf("%3.6lf%% done", temp*100);
-
-            mem = max(mem, solve(i, cnt));
+        profile.begin("load");
+        if (clique_view)
+            load_clique_view(hypergraphs[i], MAXN, use_cache, ids, clique);
+        else
+            load_dataset(graphs[i], -1, use_cache, ids, graph, protein);
+
+        profile.begin("build");
+        // The clique view is built from the hypergraph and keeps its numbering
+        if (!clique_view)
+            printf("%s", reorder_dataset(reorder, ids, graph, protein).report().c_str());
+        int cnt = ids.size();
+        // Every node of the plain graph is a protein
+        mask.set();
+        direction_optimizing = !clique_view && !top_down;
+        hypergraph_traversal = false;
+        betweenness.assign(cnt, 0);
+
+        vector<int> sources;
+        for (int i = 0; i < cnt; ++i)
+            sources.push_back(i);
+        // The clique view has no stored edges to update
+        bool update_graph = dynamic && !clique_view;
+        SourceDistances dist;
+        // Which pairs disappear depends on the other complexes, so the batch
+        // is translated against the hypergraph
+        IdMap hyper_ids;
+        CSRGraph hyper;
+        vector<char> hyper_protein;
+        if (update_graph){
+            load_dataset(hypergraphs[i], MAXN, use_cache, hyper_ids, hyper, hyper_protein);
+            dist.watch(batch_nodes(hyper, hyper_ids, MAXN, batch, ids));
         }
+        profile.begin("compute");
+        if (clique_view)
+            run_betweenness(clique, sources, cnt, 1, threads);
+        else
+            run_betweenness(graph, sources, cnt, 1, threads, update_graph ? &dist : nullptr);
         printf("\n");
 
-        memory += mem;
-        memory += getMemoryUsage(idx_to_node);
-        memory += getMemoryUsage(node_to_idx);
-        memory += getMemoryUsage2(graph, cnt);
-        memory += getMemoryUsage3(betweenness, cnt);
+        size_t rerun = 0;
+        double update_time = 0;
+        if (update_graph){
+            auto update_begin = chrono::high_resolution_clock::now();
+            GraphChanges changes;
+            clique_changes(hyper, hyper_ids, MAXN, batch, ids, changes);
+            Profiler::Scope scope(profile, profile.kernel("update"));
+            rerun = update_betweenness(graph, changes, sources, dist, threads);
+            printf("\n");
+            cnt = ids.size();
+            update_time = chrono::duration_cast<chrono::duration<double>>(chrono::high_resolution_clock::now() - update_begin).count();
+        }
 
+        profile.begin("output");
         printf("For graph representation:\n");
-        printf("Memory Used: %lld Bytes\n", memory);
+        printf("Memory Used: %llu Bytes (peak RSS %llu Bytes)\n", phases.heap_peak(), phases.rss_peak());
         auto end = chrono::high_resolution_clock::now();
         double time = chrono::duration_cast<chrono::duration<double>>(end-begin).count();
         printf("Time Taken: %lf Seconds\n", time);
+        if (update_graph)
+            printf("Incremental update: +%zu -%zu hyperedges, %zu of %zu sources rerun in %lf Seconds\n",
+                   batch.inserted.size(), batch.deleted.size(), rerun, sources.size(), update_time);
 
         double mx;
-        fout.open("Output/Betweenness/" + names[i] + ".ungraph.betweenness.txt");
-        fout<<memory<<" "<<fixed<<setprecision(9)<<time<<endl<<endl;
-        for (auto& [i, j]: node_to_idx)
-            fout<<i<<" "<<betweenness[j]<<endl;
-        fout.close();
+        ResultWriter out;
+        out.field(phases.heap_peak()).field(time).field(phases.rss_peak());
+        // Approximate runs append the guaranteed bound and the sample count
+        if (approx.enabled)
+            out.field(approx.bound_epsilon).field(approx.bound_delta).field(approx.samples);
+        out.end_line().end_line();
+        // Nodes an update left without edges are no longer part of the graph
+        for (int j: ids.sorted_indices())
+            if (!update_graph || graph.degree(j) > 0)
+                out.row(ids[j], betweenness[j]);
+        out.save("Output/Betweenness/" + names[i] + ".ungraph.betweenness.txt");
 
         mx = 0;
         for (int i = 0; i < cnt; ++i)
           mx = max(mx, betweenness[i]);
 
         printf("The node(s) with the greatest betweenness are ");
-        for (int i = 0; i <= cnt; ++i)
+        for (int i = 0; i < cnt; ++i)
           if (fabs(mx - betweenness[i]) < epsilon)
-            printf("%d, ", idx_to_node[i]);
+            printf("%d, ", ids[i]);
         printf("\b\b.\n");
-
-        fin.close();
+        profile.end();
+        printf("Memory by phase:\n%s", phases.report().c_str());
+        if (profile.enabled())
+            profile.write_json("Output/Betweenness/" + names[i] + ".ungraph.betweenness.profile.json", "betweenness",
+                               names[i], "ungraph");
+        // Release the graph so the hypergraph run is measured on its own
+        clique = CliqueView();
+        graph = CSRGraph();
+        ids = IdMap();
+        protein = vector<char>();
+        betweenness = vector<double>();
+        dist = SourceDistances();
 
 
 
@@ -222,73 +573,78 @@ int main(){
 
 
         // Hypergraph
-        int hyperEdge = 0;
-        fin.open(hypergraphs[i]);
-
-        memory = 0;
+        profile.reset();
         begin = chrono::high_resolution_clock::now();
 
-        for (int i = 0; i < MAXN + MAXHE; ++i)
-            graph[i].clear();
-        idx_to_node.clear();
-        node_to_idx.clear();
-        betweenness.assign(MAXN + MAXHE, 0);
+        profile.begin("load");
+        int hyperedge_count = load_dataset(hypergraphs[i], MAXN, use_cache, ids, graph, protein);
 
-        string line;
-        cnt = 0;
+        profile.begin("build");
+        printf("%s", reorder_dataset(reorder, ids, graph, protein).report().c_str());
+        cnt = ids.size();
         mask.reset();
-        while(getline(fin, line)){
-            stringstream buffer(line);
-            v = MAXN + hyperEdge;
-            idx_to_node[cnt] = v;
-            node_to_idx[v] = cnt++;
-            v = node_to_idx[v];
-            while(buffer>>u){
-                if(!node_to_idx.count(u)){
-                    idx_to_node[cnt] = u;
-                    node_to_idx[u] = cnt++;
-                }
-                u = node_to_idx[u];
-                mask.set(u);
-                graph[u].push_back(v);
-                graph[v].push_back(u);
-          }
-          ++hyperEdge;
-        }
-
-        mem = 0;
-        j = 0;
-        for (int i = 0; i < cnt; ++i){
-            if (!mask[i])
-                continue;
-
-            double temp = double(++j)/(cnt-hyperEdge);
-
-            printf("\b\b\b\b\b\b\b\b\b\b\b\b\b\b\b");
-            printf("%3.6lf%% done", temp*100);
-
-            mem = max(mem, solve(i, cnt));
+        for (int i = 0; i < cnt; ++i)
+            if (protein[i])
+                mask.set(i);
+        // The bipartite graph has no dense cliques for bottom-up steps to skip
+        direction_optimizing = false;
+        hypergraph_traversal = !bipartite_bfs;
+        betweenness.assign(cnt, 0);
+
+        // Only original protein nodes act as sources
+        sources.clear();
+        for (int i = 0; i < cnt; ++i)
+            if (mask[i])
+                sources.push_back(i);
+        HypergraphReduction reduction;
+        if (reduce){
+            reduction.build(graph, protein);
+            printf("Reduced hypergraph: %d protein classes for %zu proteins, %d distinct hyperedges of %d, "
+                   "%lld incidences removed\n", reduction.num_protein_classes(), sources.size(),
+                   reduction.num_hyperedge_classes(), hyperedge_count, reduction.arcs_removed());
         }
+        if (dynamic)
+            dist.watch(batch_nodes(graph, ids, MAXN, batch, ids));
+        profile.begin("compute");
+        if (reduce)
+            run_reduced(reduction, cnt, threads);
+        else
+            run_betweenness(graph, sources, cnt, 2, threads, dynamic ? &dist : nullptr);
         printf("\n");
 
-        memory += mem;
-        memory += getMemoryUsage(idx_to_node);
-        memory += getMemoryUsage(node_to_idx);
-        memory += getMemoryUsage2(graph, cnt);
-        memory += getMemoryUsage3(betweenness, cnt);
+        if (dynamic){
+            auto update_begin = chrono::high_resolution_clock::now();
+            Profiler::Scope scope(profile, profile.kernel("update"));
+            GraphChanges changes;
+            bipartite_changes(graph, ids, MAXN, hyperedge_count, batch, changes);
+            for (int v = cnt; v < ids.size(); ++v)
+                if (ids[v] < MAXN)
+                    mask.set(v);
+            rerun = update_betweenness(graph, changes, sources, dist, threads);
+            printf("\n");
+            cnt = ids.size();
+            update_time = chrono::duration_cast<chrono::duration<double>>(chrono::high_resolution_clock::now() - update_begin).count();
+        }
 
+        profile.begin("output");
         printf("For hypergraph representation:\n");
-        printf("Memory Used: %lld Bytes\n", memory);
+        printf("Memory Used: %llu Bytes (peak RSS %llu Bytes)\n", phases.heap_peak(), phases.rss_peak());
         end = chrono::high_resolution_clock::now();
         time = chrono::duration_cast<chrono::duration<double>>(end-begin).count();
         printf("Time Taken: %lf Seconds\n", time);
-
-        fout.open("Output/Betweenness/" + names[i] + ".cmty.betweenness.txt");
-        fout<<memory<<" "<<fixed<<setprecision(9)<<time<<endl<<endl;
-        for (auto& [i, j]: node_to_idx)
-            if (i < MAXN)
-                fout<<i<<" "<<betweenness[j]<<endl;
-        fout.close();
+        if (dynamic)
+            printf("Incremental update: +%zu -%zu hyperedges, %zu of %zu sources rerun in %lf Seconds\n",
+                   batch.inserted.size(), batch.deleted.size(), rerun, sources.size(), update_time);
+
+        out = ResultWriter();
+        out.field(phases.heap_peak()).field(time).field(phases.rss_peak());
+        if (approx.enabled)
+            out.field(approx.bound_epsilon).field(approx.bound_delta).field(approx.samples);
+        out.end_line().end_line();
+        for (int j: ids.sorted_indices())
+            if (ids[j] < MAXN && (!dynamic || graph.degree(j) > 0))
+                out.row(ids[j], betweenness[j]);
+        out.save("Output/Betweenness/" + names[i] + ".cmty.betweenness.txt");
 
         mx = 0;
         for (int i = 0; i < cnt; ++i)
@@ -297,10 +653,17 @@ int main(){
         printf("The node(s) with the greatest betweenness are ");
         for (int i = 0; i < cnt; ++i)
           if (mask[i] && fabs(mx - betweenness[i]) < epsilon)
-            printf("%d, ", idx_to_node[i]);
+            printf("%d, ", ids[i]);
         printf("\b\b.\n");
-
-        fin.close();
+        profile.end();
+        printf("Memory by phase:\n%s", phases.report().c_str());
+        if (profile.enabled())
+            profile.write_json("Output/Betweenness/" + names[i] + ".cmty.betweenness.profile.json", "betweenness",
+                               names[i], "cmty");
+        graph = CSRGraph();
+        ids = IdMap();
+        protein = vector<char>();
+        betweenness = vector<double>();
 
 
         printf("%s\n", string(80, '=').c_str());
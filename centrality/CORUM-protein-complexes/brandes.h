@@ -0,0 +1,216 @@
+#ifndef BRANDES_H
+#define BRANDES_H
+
+#include <type_traits>
+#include <vector>
+#include "csr-graph.h"
+#include "visit-marks.h"
+#include "direction-bfs.h"
+#include "hypergraph-bfs.h"
+
+/*
+ * Per-worker state and the two passes of Brandes' algorithm, shared by
+ * betweenness-centrality.cpp and all-centrality.cpp.
+ *
+ * count_paths() is the forward pass: a BFS from the source that counts
+ * shortest paths (sigma) and, unless predecessors are implicit, records each
+ * vertex's predecessors. accumulate() is the backward pass: it walks the
+ * reached vertices in reverse BFS order and adds every vertex's dependency to
+ * `betweenness`. levels() is the forward BFS alone, for distance measures.
+ *
+ * After a pass `touched` holds the reached vertices in the order they were
+ * discovered (the source first) and `level` their BFS levels; the scratch
+ * entries of a vertex are only valid while it is marked in `visited`. Nothing
+ * is reset up front: a vertex's entries are cleared when it is first reached,
+ * so a traversal costs time proportional to the part of the graph explored.
+ *
+ * BrandesMode picks the kernel for the graph at hand:
+ *   - direction_optimizing: a stored undirected graph, traversed with
+ *     bottom-up steps once the frontier is large (see direction-bfs.h).
+ *   - hypergraph: the bipartite hypergraph, traversed in hypergraph hops
+ *     (see hypergraph-bfs.h), with `weight` set on a reduced hypergraph.
+ *   - implicit_predecessors: no predecessor lists; the backward pass finds
+ *     the predecessors of v among its neighbors as the vertices one level
+ *     closer, so a worker holds O(V) scratch at the cost of rescanning edges.
+ * The first two only apply to a CSRGraph; any other graph goes through its
+ * Scanner.
+ */
+struct BrandesMode {
+    bool direction_optimizing = false;
+    bool hypergraph = false;
+    bool implicit_predecessors = false;
+    const std::vector<double>* weight = nullptr;
+};
+
+struct BrandesWorker {
+    BrandesMode mode;
+    std::vector<int> level;
+    std::vector<double> sigma;
+    std::vector<double> delta;
+    std::vector<std::vector<int>> predecessor;
+    VisitMarks visited;
+    std::vector<int> touched;       // vertices reached by the last pass, in BFS order
+    std::vector<int> opened;        // hyperedges opened by the last hypergraph traversal
+    DirectionBFS bfs;
+    HypergraphBFS hypergraph;
+    std::vector<double> betweenness;
+
+    // Sizes the scratch arrays for `cnt` vertices; without `paths` only what
+    // levels() needs
+    void init(int cnt, const BrandesMode& m, bool paths = true) {
+        mode = m;
+        level.assign(cnt, 0);
+        visited = VisitMarks();
+        visited.resize(cnt);
+        touched.clear();
+        opened.clear();
+        if (paths) {
+            sigma.assign(cnt, 0);
+            delta.assign(cnt, 0);
+            // The hypergraph traversal keeps its own DAG lists
+            predecessor.assign(mode.implicit_predecessors || mode.hypergraph ? 0 : cnt, std::vector<int>());
+            betweenness.assign(cnt, 0);
+        }
+    }
+
+    // Forward pass from `source`. With a `target` (path sampling) the generic
+    // search runs and stops once every shortest path to the target is known.
+    template <class Graph>
+    void count_paths(const Graph& g, typename Graph::Scanner& scan, int source, int target = -1) {
+        if (target < 0) {
+            if (const CSRGraph* hyper = as_csr(g, mode.hypergraph)) {
+                hypergraph.paths(*hyper, source, visited, touched, opened, level, sigma, mode.weight);
+                return;
+            }
+            if (const CSRGraph* direct = as_csr(g, mode.direction_optimizing)) {
+                // Every frontier neighbor of a vertex is a predecessor, so
+                // bottom-up steps still visit all of them; only the edges into
+                // vertices reached earlier are skipped
+                bool record = !mode.implicit_predecessors;
+                bfs.run(*direct, source, visited, touched, level, true,
+                        [&](int v) {
+                            sigma[v] = v == source;
+                            delta[v] = 0;
+                            if (record)
+                                predecessor[v].clear();
+                        },
+                        [&](int u, int v) {
+                            sigma[v] += sigma[u];
+                            if (record)
+                                predecessor[v].push_back(u);
+                        });
+                return;
+            }
+        }
+        search(scan, source, target);
+    }
+
+    // BFS levels from `source` only; expand() may skip neighbors already
+    // reached.
+    template <class Graph>
+    void levels(const Graph& g, typename Graph::Scanner& scan, int source) {
+        if (const CSRGraph* hyper = as_csr(g, mode.hypergraph)) {
+            hypergraph.levels(*hyper, source, visited, touched, opened, level);
+            return;
+        }
+        if (const CSRGraph* direct = as_csr(g, mode.direction_optimizing)) {
+            bfs.run(*direct, source, visited, touched, level, false, [](int) {}, [](int, int) {});
+            return;
+        }
+        visited.clear();
+        touched.clear();
+        visited.mark(source);
+        touched.push_back(source);
+        level[source] = 0;
+        scan.reset();
+        for (size_t head = 0; head < touched.size(); ++head) {
+            int current = touched[head];
+            scan.expand(current, [&](int node) {
+                if (visited.mark(node)) {
+                    level[node] = level[current] + 1;
+                    touched.push_back(node);
+                }
+            });
+        }
+    }
+
+    // Backward pass after a full count_paths() from `source`: every vertex in
+    // `counted` is a path target. Every delta[u] receives its terms in the
+    // same order with or without predecessor lists, so both give the same
+    // results.
+    template <class Graph, class Counted>
+    void accumulate(const Graph& g, typename Graph::Scanner& scan, int source, const Counted& counted) {
+        if (as_csr(g, mode.hypergraph)) {
+            // A protein class as source stands for each of its members
+            double copies = mode.weight ? (*mode.weight)[source] : 1;
+            hypergraph.dependencies(source, touched, opened, level, sigma, delta,
+                                    [&](int q, double d) { betweenness[q] += copies * d / 2; }, mode.weight);
+            return;
+        }
+        for (size_t k = touched.size(); k-- > 0;) {
+            int v = touched[k];
+            if (mode.implicit_predecessors) {
+                // A full traversal reaches every neighbor of v, so their levels are valid
+                scan.neighbors(v, [&](int u) {
+                    if (level[u] == level[v] - 1)
+                        delta[u] += (sigma[u] / sigma[v]) * (counted[v] + delta[v]);
+                });
+            } else {
+                for (int u : predecessor[v])
+                    delta[u] += (sigma[u] / sigma[v]) * (counted[v] + delta[v]);
+            }
+            if (v != source)
+                betweenness[v] += delta[v] / 2;
+        }
+    }
+
+private:
+    // `g` if it is a CSRGraph and `on` is set, for the kernels that need one
+    template <class Graph>
+    static const CSRGraph* as_csr(const Graph& g, bool on) {
+        if constexpr (std::is_same<Graph, CSRGraph>::value)
+            return on ? &g : nullptr;
+        (void)g;
+        (void)on;
+        return nullptr;
+    }
+
+    // Queue-based forward pass through the graph's Scanner
+    template <class Scanner>
+    void search(Scanner& scan, int source, int target) {
+        bool record = !mode.implicit_predecessors;
+        auto reach = [&](int v) {
+            sigma[v] = 0;
+            delta[v] = 0;
+            if (record)
+                predecessor[v].clear();
+            touched.push_back(v);
+        };
+        visited.clear();
+        touched.clear();
+
+        visited.mark(source);
+        reach(source);
+        sigma[source] = 1;
+        level[source] = 0;
+        for (size_t head = 0; head < touched.size(); ++head) {
+            int current = touched[head];
+            if (target >= 0 && visited.marked(target) && level[current] >= level[target])
+                break;
+            scan.neighbors(current, [&](int node) {
+                if (visited.mark(node)) {
+                    reach(node);
+                    level[node] = level[current] + 1;
+                }
+                // Update sigma of node if the path through current is shortest
+                if (level[node] == level[current] + 1) {
+                    sigma[node] += sigma[current];
+                    if (record)
+                        predecessor[node].push_back(current);
+                }
+            });
+        }
+    }
+};
+
+#endif // BRANDES_H
@@ -0,0 +1,75 @@
+#ifndef CLI_OPTIONS_H
+#define CLI_OPTIONS_H
+
+#include <cstdio>
+#include <cstdlib>
+#include <initializer_list>
+#include <map>
+#include <string>
+#include <vector>
+
+/*
+ * Minimal command-line parser shared by the centrality programs.
+ * Accepts "--name" (stored as "1") and "--name=value". Each program passes
+ * its flags to known(), which rejects any other name and any argument of
+ * another form (such as "-threads=4"), so a typo never silently changes the
+ * computation.
+ */
+class Options {
+public:
+    Options(int argc, char* argv[]) {
+        for (int i = 1; i < argc; ++i) {
+            std::string arg = argv[i];
+            if (arg.size() < 3 || arg.compare(0, 2, "--") != 0) {
+                stray.push_back(arg);
+                continue;
+            }
+            size_t eq = arg.find('=');
+            if (eq == std::string::npos)
+                values[arg.substr(2)] = "1";
+            else
+                values[arg.substr(2, eq - 2)] = arg.substr(eq + 1);
+        }
+    }
+
+    // Reports every flag not in `names` and every argument that is not a
+    // flag; returns false if there was one.
+    bool known(std::initializer_list<const char*> names) const {
+        bool ok = stray.empty();
+        for (const auto& arg : stray)
+            fprintf(stderr, "ERROR: Unrecognized argument '%s' (options are --name or --name=value)\n", arg.c_str());
+        for (const auto& entry : values) {
+            bool found = false;
+            for (const char* name : names)
+                if (entry.first == name) found = true;
+            if (!found) {
+                fprintf(stderr, "ERROR: Unknown option '--%s'\n", entry.first.c_str());
+                ok = false;
+            }
+        }
+        return ok;
+    }
+
+    bool has(const std::string& name) const { return values.count(name) > 0; }
+
+    std::string get(const std::string& name, const std::string& def = "") const {
+        auto it = values.find(name);
+        return it == values.end() ? def : it->second;
+    }
+
+    long long get_int(const std::string& name, long long def) const {
+        auto it = values.find(name);
+        return it == values.end() ? def : std::atoll(it->second.c_str());
+    }
+
+    double get_double(const std::string& name, double def) const {
+        auto it = values.find(name);
+        return it == values.end() ? def : std::atof(it->second.c_str());
+    }
+
+private:
+    std::map<std::string, std::string> values;
+    std::vector<std::string> stray;
+};
+
+#endif // CLI_OPTIONS_H
@@ -0,0 +1,146 @@
+#ifndef CLIQUE_VIEW_H
+#define CLIQUE_VIEW_H
+
+#include <string>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include "csr-graph.h"
+#include "id-map.h"
+#include "graph-cache.h"
+
+/*
+ * Implicit clique expansion of a hypergraph.
+ *
+ * prepare_corum_data.py turns every complex of N proteins into N*(N-1)/2
+ * pairwise edges, so the .graph file grows quadratically with complex size.
+ * This view answers the same neighbor queries from the hypergraph itself: the
+ * neighbors of v are the union of the members of v's hyperedges, minus v. Only
+ * the incidence lists are stored (one entry per protein-complex membership).
+ *
+ * Node set and semantics match the .graph file: proteins that share no complex
+ * with another protein have no pairwise edge and are left out, and two proteins
+ * that share several complexes are still joined by a single edge.
+ */
+class CliqueView {
+public:
+    // Builds the view from the bipartite model produced by load_dataset():
+    // nodes with `protein[v]` set are members, all others are hyperedges. On
+    // entry `ids` maps bipartite indices; on return it maps view indices.
+    void build(const CSRGraph& bipartite, const std::vector<char>& protein, IdMap& ids) {
+        int total = bipartite.size();
+        std::vector<int> original = ids.nodes();
+        std::vector<int> mark(total, -1);
+
+        // Clique degree of every protein = number of distinct co-members
+        std::vector<int> view_index(total, -1);
+        degrees.clear();
+        ids.clear();
+        for (int v = 0; v < total; ++v) {
+            if (!protein[v]) continue;
+            int d = 0;
+            mark[v] = v;
+            for (int e : bipartite.neighbors(v))
+                for (int w : bipartite.neighbors(e))
+                    if (mark[w] != v) { mark[w] = v; ++d; }
+            if (d == 0) continue;
+            view_index[v] = ids.intern(original[v]);
+            degrees.push_back(d);
+        }
+        num_nodes = ids.size();
+
+        // Hyperedges with a single distinct member contribute no pairs
+        std::fill(mark.begin(), mark.end(), -1);
+        std::vector<std::pair<int, int>> pins;
+        num_edges = 0;
+        for (int e = 0; e < total; ++e) {
+            if (protein[e]) continue;
+            size_t first = pins.size();
+            for (int w : bipartite.neighbors(e))
+                if (mark[w] != e && view_index[w] >= 0) {
+                    mark[w] = e;
+                    pins.push_back({view_index[w], num_nodes + num_edges});
+                }
+            if (pins.size() - first < 2) pins.resize(first);
+            else ++num_edges;
+        }
+        incidence.build(num_nodes + num_edges, pins);
+    }
+
+    int size() const { return num_nodes; }
+    int num_hyperedges() const { return num_edges; }
+    int degree(int v) const { return degrees[v]; }
+
+    /*
+     * Per-thread traversal state. neighbors() reports every neighbor of v
+     * exactly once (what Brandes' path counting needs); expand() may skip
+     * neighbors reached earlier in the same traversal, because each hyperedge
+     * is opened at most once between reset() calls, which is all a plain BFS
+     * needs and keeps it linear in the number of memberships.
+     */
+    class Scanner {
+    public:
+        explicit Scanner(const CliqueView& g)
+            : view(g), node_mark(g.num_nodes, 0), edge_mark(g.num_edges, 0) {}
+
+        void reset() {
+            if (++traversal == 0) {
+                std::fill(edge_mark.begin(), edge_mark.end(), 0);
+                traversal = 1;
+            }
+        }
+
+        template <class F>
+        void neighbors(int v, F f) {
+            if (++call == 0) {
+                std::fill(node_mark.begin(), node_mark.end(), 0);
+                call = 1;
+            }
+            node_mark[v] = call;
+            for (int e : view.incidence.neighbors(v))
+                for (int w : view.incidence.neighbors(e))
+                    if (node_mark[w] != call) {
+                        node_mark[w] = call;
+                        f(w);
+                    }
+        }
+
+        template <class F>
+        void expand(int v, F f) {
+            for (int e : view.incidence.neighbors(v)) {
+                unsigned& seen = edge_mark[e - view.num_nodes];
+                if (seen == traversal) continue;
+                seen = traversal;
+                for (int w : view.incidence.neighbors(e))
+                    if (w != v) f(w);
+            }
+        }
+
+    private:
+        const CliqueView& view;
+        std::vector<unsigned> node_mark;
+        std::vector<unsigned> edge_mark;
+        unsigned call = 0;
+        unsigned traversal = 0;
+    };
+
+private:
+    int num_nodes = 0;
+    int num_edges = 0;
+    // Proteins are nodes [0, num_nodes), hyperedge e is node num_nodes + e
+    CSRGraph incidence;
+    std::vector<int> degrees;
+};
+
+// Loads a .hypergraph file (through the binary cache when enabled) and builds
+// its clique-expansion view. Returns false if the file cannot be read.
+inline bool load_clique_view(const std::string& path, int hyperedge_base, bool use_cache, IdMap& ids,
+                             CliqueView& view) {
+    CSRGraph bipartite;
+    std::vector<char> protein;
+    bool ok = load_dataset(path, hyperedge_base, use_cache, ids, bipartite, protein) >= 0;
+    view.build(bipartite, protein, ids);
+    return ok;
+}
+
+#endif // CLIQUE_VIEW_H
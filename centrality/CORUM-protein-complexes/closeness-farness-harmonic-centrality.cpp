@@ -1,15 +1,26 @@
 #include <iostream>
 #include <fstream>
-#include <sstream>
 #include <string>
 #include <vector>
 #include <bitset>
-#include <queue>
 #include <cmath>
-#include <map>
 #include <chrono>
 #include <iomanip>
 #include <algorithm>
+#include <cstdint>
+#include "csr-graph.h"
+#include "id-map.h"
+#include "graph-cache.h"
+#include "clique-view.h"
+#include "cli-options.h"
+#include "graph-updates.h"
+#include "profiler.h"
+#include "result-writer.h"
+#include "visit-marks.h"
+#include "direction-bfs.h"
+#include "hypergraph-bfs.h"
+#include "hypergraph-reduction.h"
+#include "vertex-order.h"
 
 using namespace std;
 
@@ -24,63 +35,396 @@ const int MAXN = 4e6;
 const int MAXHE = 3e6;
 const double epsilon = 1e-9;
 
-vector<int> graph[MAXN + MAXHE];
-vector<int> level(MAXN + MAXHE);
-map<int, int> idx_to_node;
-map<int, int> node_to_idx;
+CSRGraph graph;
+CliqueView clique;
+vector<char> protein;
+vector<int> level;
+VisitMarks visited;
+vector<int> touched;
+DirectionBFS direction_bfs;
+// Set for the stored .ungraph: bfs_direction() replaces bfs() there
+bool direction_optimizing = false;
+// Set for the .cmty bipartite graph: bfs_hypergraph() replaces bfs() there
+bool hypergraph_traversal = false;
+HypergraphBFS hypergraph_bfs;
+vector<int> opened;
+IdMap ids;
 vector<double> farness;
 vector<double> closeness;
 vector<double> harmonic;
-bitset<MAXN + MAXHE> visited;
 bitset<MAXN + MAXHE> mask;
+// --profile times phases and kernels and writes <output>.profile.json
+Profiler profile;
 
-// --- Memory calculation utilities ---
-template<class K, class V>
-unsigned long long getMemoryUsage(const map<K, V>& m) {
-    unsigned long long nodeSize = sizeof(K) + sizeof(V) + 3 * sizeof(void*) + sizeof(bool);
-    unsigned long long adminSize = 3 * sizeof(void*) + sizeof(size_t);
-    return adminSize + m.size() * nodeSize;
+// --- Breadth-First Search to calculate shortest path levels from a source node ---
+// `touched` doubles as the queue and keeps the reached nodes in BFS order;
+// the levels of nodes outside it are stale, so nothing is reset per source.
+template <class Scanner>
+void bfs(Scanner& scan, int n, int source) {
+    visited.resize(n);
+    if ((int)level.size() < n) level.resize(n);
+    visited.clear();
+    touched.clear();
+    scan.reset();
+
+    visited.mark(source);
+    level[source] = 0;
+    touched.push_back(source);
+    for (size_t head = 0; head < touched.size(); ++head) {
+        int current_vertex = touched[head];
+        scan.expand(current_vertex, [&](int node) {
+            if (visited.mark(node)) {
+                touched.push_back(node);
+                level[node] = level[current_vertex] + 1;
+            }
+        });
+    }
 }
 
-unsigned long long getMemoryUsage2(int cnt) {
-    unsigned long long totalSize = 0;
-    for (int i = 0; i < cnt; ++i)
-        totalSize += graph[i].size() * sizeof(int);
-    return totalSize;
+// --- bfs() on the stored undirected graph with the direction-optimizing kernel ---
+// Leaves `level` and `touched` as bfs() does, but switches to bottom-up steps
+// over a bitmap frontier once the frontier covers most of the remaining edges.
+void bfs_direction(int source) {
+    direction_bfs.run(graph, source, visited, touched, level, false, [](int) {}, [](int, int) {});
 }
 
-template<class T>
-unsigned long long getMemoryUsage3(const vector<T>& v) {
-    return v.capacity() * sizeof(T);
+// --- bfs() on the bipartite graph in hypergraph hops (see hypergraph-bfs.h) ---
+// `touched` gets only the reached proteins, and their levels need no halving;
+// the opened hyperedges go to `opened`.
+void bfs_hypergraph(int n, int source) {
+    visited.resize(n);
+    if ((int)level.size() < n) level.resize(n);
+    hypergraph_bfs.levels(graph, source, visited, touched, opened, level);
 }
 
-// --- Breadth-First Search to calculate shortest path levels from a source node ---
-int bfs(int source) {
-    queue<int> q;
-    q.push(source);
-    visited.reset();
-    level.assign(level.size(), 0);
-
-    visited[source] = true;
-    int max_q_size = 0;
-    while (!q.empty()) {
-        max_q_size = max(max_q_size, (int)q.size());
-        int current_vertex = q.front();
-        q.pop();
-        for (int node : graph[current_vertex]) {
-            if (!visited[node]) {
-                q.push(node);
-                visited[node] = true;
-                level[node] = level[current_vertex] + 1;
+// --- Distance sums of one source from the levels of the last bfs() ---
+// Counts every reached node but the source (only nodes in `mask` with
+// `only_proteins`), dividing bipartite levels by `hop`. With `record`, the
+// levels are kept so updates can tell which sources they affect; they are
+// recorded in bipartite units after bfs_hypergraph() as well.
+void level_sums(int n, int source, int hop, bool only_proteins, double& dist_sum, double& inv_sum, double& reached,
+                SourceDistances* record = nullptr) {
+    dist_sum = inv_sum = reached = 0;
+    int scale = hypergraph_traversal ? 2 : 1;
+    if (record) record->begin(source, n);
+    if (record && hypergraph_traversal)
+        for (int e : opened) record->set(source, e, 2 * level[e] + 1);
+    for (int l : touched) {
+        if (record) record->set(source, l, scale * level[l]);
+        if (l == source || (only_proteins && !mask[l])) continue;
+        dist_sum += (double)level[l] / hop;
+        inv_sum += (double)hop / level[l];
+        ++reached;
+    }
+}
+
+// Applies `changes` to `graph` and reruns bfs() only from the sources whose
+// distances may change, replacing their sums; new nodes (new protein nodes
+// with `only_proteins`) join `sources`. Returns the number of sources rerun.
+size_t update_sums(const GraphChanges& changes, vector<int>& sources, int hop, bool only_proteins,
+                   SourceDistances& dist, vector<double>& dist_sum, vector<double>& inv_sum,
+                   vector<double>& reached) {
+    vector<size_t> affected;
+    for (size_t s = 0; s < sources.size(); ++s)
+        if (dist.affected(sources[s], changes, true)) affected.push_back(s);
+    int old_cnt = graph.size();
+    apply_changes(graph, changes);
+    int n = graph.size();
+    for (int v = old_cnt; v < n; ++v) {
+        if (only_proteins && !mask[v]) continue;
+        affected.push_back(sources.size());
+        sources.push_back(v);
+    }
+    dist_sum.resize(sources.size(), 0);
+    inv_sum.resize(sources.size(), 0);
+    reached.resize(sources.size(), 0);
+    dist.resize(n);
+    CSRGraph::Scanner scan(graph);
+    for (size_t s : affected) {
+        if (direction_optimizing) bfs_direction(sources[s]);
+        else if (hypergraph_traversal) bfs_hypergraph(n, sources[s]);
+        else bfs(scan, n, sources[s]);
+        level_sums(n, sources[s], hypergraph_traversal ? 1 : hop, only_proteins, dist_sum[s], inv_sum[s], reached[s], &dist);
+    }
+    return affected.size();
+}
+
+// --- Distance sums of every source from its class in `reduction` ---
+// One hypergraph traversal per protein class of the reduced graph; every
+// source gets the sums of its class.
+void reduced_sums(const HypergraphReduction& reduction, const vector<int>& sources, vector<double>& dist_sum,
+                  vector<double>& inv_sum, vector<double>& reached) {
+    int n = reduction.size();
+    visited.resize(n);
+    if ((int)level.size() < n) level.resize(n);
+    vector<double> class_dist(n, 0), class_inv(n, 0), class_reached(n, 0);
+    int done = 0;
+    for (int x = 0; x < n; ++x) {
+        if (!reduction.protein(x)) continue;
+        printf("\b\b\b\b\b\b\b\b\b\b\b\b\b\b\b"); // Progress bar
+        printf("%3.6lf%% done", (double)(++done) / reduction.num_protein_classes() * 100);
+        hypergraph_bfs.levels(reduction.graph(), x, visited, touched, opened, level);
+        reduction.distance_sums(x, touched, level, class_dist[x], class_inv[x], class_reached[x]);
+    }
+    for (size_t s = 0; s < sources.size(); ++s) {
+        int x = reduction.reduced_index(sources[s]);
+        dist_sum[s] = class_dist[x];
+        inv_sum[s] = class_inv[x];
+        reached[s] = class_reached[x];
+    }
+}
+
+// --- Bit-parallel multi-source BFS (MS-BFS) ---
+// Every vertex carries one bit per source in `seen`, `frontier` and `next`, so
+// one sweep over the adjacency advances MSBFS_LANES traversals by a level.
+// Distances are summed per level as vertices are discovered (bipartite levels
+// are divided by `hop`), which replaces the per-source rescan of all nodes.
+// With `only_proteins` set, only nodes in `mask` are counted as reached.
+const int MSBFS_WORDS = 4;
+const int MSBFS_LANES = 64 * MSBFS_WORDS;
+
+template <class Scanner>
+void msbfs(Scanner& scan, int n, const vector<int>& sources, int hop, bool only_proteins,
+           vector<double>& dist_sum, vector<double>& inv_sum, vector<double>& reached) {
+    size_t words = (size_t)n * MSBFS_WORDS;
+    vector<uint64_t> seen(words), frontier(words), next(words);
+    vector<int> found(MSBFS_LANES, 0);
+    dist_sum.assign(sources.size(), 0);
+    inv_sum.assign(sources.size(), 0);
+    reached.assign(sources.size(), 0);
+
+    for (size_t first = 0; first < sources.size(); first += MSBFS_LANES) {
+        int lanes = (int)min<size_t>(MSBFS_LANES, sources.size() - first);
+        fill(seen.begin(), seen.end(), 0);
+        fill(frontier.begin(), frontier.end(), 0);
+        for (int b = 0; b < lanes; ++b) {
+            size_t at = (size_t)sources[first + b] * MSBFS_WORDS + b / 64;
+            seen[at] |= 1ull << (b % 64);
+            frontier[at] |= 1ull << (b % 64);
+        }
+
+        for (int lvl = 1; ; ++lvl) {
+            fill(next.begin(), next.end(), 0);
+            for (int v = 0; v < n; ++v) {
+                const uint64_t* f = &frontier[(size_t)v * MSBFS_WORDS];
+                uint64_t any = 0;
+                for (int w = 0; w < MSBFS_WORDS; ++w) any |= f[w];
+                if (!any) continue;
+                scan.neighbors(v, [&](int u) {
+                    uint64_t* x = &next[(size_t)u * MSBFS_WORDS];
+                    for (int w = 0; w < MSBFS_WORDS; ++w) x[w] |= f[w];
+                });
             }
+
+            bool active = false;
+            for (int u = 0; u < n; ++u) {
+                uint64_t* x = &next[(size_t)u * MSBFS_WORDS];
+                uint64_t* s = &seen[(size_t)u * MSBFS_WORDS];
+                uint64_t any = 0;
+                for (int w = 0; w < MSBFS_WORDS; ++w) {
+                    x[w] &= ~s[w];
+                    s[w] |= x[w];
+                    any |= x[w];
+                }
+                if (!any) continue;
+                active = true;
+                if (only_proteins && !mask[u]) continue;
+                for (int w = 0; w < MSBFS_WORDS; ++w)
+                    for (uint64_t bits = x[w]; bits; bits &= bits - 1)
+                        ++found[w * 64 + __builtin_ctzll(bits)];
+            }
+            if (!active) break;
+            frontier.swap(next);
+
+            double dist = (double)lvl / hop, inv = (double)hop / lvl;
+            for (int b = 0; b < lanes; ++b) {
+                if (!found[b]) continue;
+                dist_sum[first + b] += found[b] * dist;
+                inv_sum[first + b] += found[b] * inv;
+                reached[first + b] += found[b];
+                found[b] = 0;
+            }
+        }
+
+        printf("\b\b\b\b\b\b\b\b\b\b\b\b\b\b\b"); // Progress bar
+        printf("%3.6lf%% done", (double)(first + lanes) / sources.size() * 100);
+    }
+}
+
+// --- HyperBall: approximate distance sums from HyperLogLog counters ---
+// Every vertex keeps a HyperLogLog sketch (2^log2m one-byte registers) of the
+// nodes within distance t of it; one pass taking register-wise maxima over the
+// neighbors turns radius t into t + 1. The growth of a sketch's estimate
+// between passes approximates the number of nodes first reached at distance t,
+// so the whole run costs one sweep over the adjacency per level of the
+// diameter. Only nodes in `mask` are inserted when `only_proteins` is set, and
+// bipartite levels are divided by `hop`, as in the exact code.
+//
+// A sketch only sees a neighbor whose hash raises one of its registers, so in
+// a component of a few nodes the estimate can stay put and a node with
+// neighbors would read as isolated (closeness and farness 0). Sources in
+// components of fewer than 2^log2m nodes, and any source whose sketch never
+// grew although it has neighbors, get an exact BFS instead; both are cheap.
+uint64_t hll_hash(uint64_t x) {
+    x += 0x9E3779B97F4A7C15ull;
+    x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+    x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+    return x ^ (x >> 31);
+}
+
+double hll_estimate(const uint8_t* reg, int m) {
+    double sum = 0;
+    int zeros = 0;
+    for (int r = 0; r < m; ++r) {
+        sum += ldexp(1.0, -reg[r]);
+        zeros += (reg[r] == 0);
+    }
+    double alpha = m == 16 ? 0.673 : m == 32 ? 0.697 : m == 64 ? 0.709 : 0.7213 / (1 + 1.079 / m);
+    double estimate = alpha * m * m / sum;
+    // Small-range correction (linear counting)
+    if (estimate <= 2.5 * m && zeros > 0)
+        estimate = m * log((double)m / zeros);
+    return estimate;
+}
+
+template <class Scanner>
+void hyperball(Scanner& scan, int n, const vector<int>& sources, int hop, bool only_proteins,
+               vector<double>& dist_sum, vector<double>& inv_sum, vector<double>& reached, int log2m) {
+    int m = 1 << log2m;
+    vector<uint8_t> counter((size_t)n * m, 0), next_counter((size_t)n * m);
+    vector<double> size(n, 0);
+    vector<double> node_dist(n, 0), node_inv(n, 0), node_reached(n, 0);
+
+    for (int v = 0; v < n; ++v) {
+        if (only_proteins && !mask[v]) continue;
+        uint64_t h = hll_hash(v);
+        uint64_t rest = h << log2m;
+        int rho = rest ? __builtin_clzll(rest) + 1 : 64 - log2m + 1;
+        counter[(size_t)v * m + (h >> (64 - log2m))] = rho;
+    }
+    for (int v = 0; v < n; ++v)
+        size[v] = hll_estimate(&counter[(size_t)v * m], m);
+
+    for (int lvl = 1; ; ++lvl) {
+        bool changed = false;
+        for (int v = 0; v < n; ++v) {
+            uint8_t* x = &next_counter[(size_t)v * m];
+            const uint8_t* own = &counter[(size_t)v * m];
+            copy(own, own + m, x);
+            scan.neighbors(v, [&](int u) {
+                const uint8_t* y = &counter[(size_t)u * m];
+                for (int r = 0; r < m; ++r) x[r] = max(x[r], y[r]);
+            });
+            if (equal(own, own + m, x)) continue;
+            changed = true;
+            double estimate = max(size[v], hll_estimate(x, m));
+            double found = estimate - size[v];
+            size[v] = estimate;
+            node_dist[v] += found * lvl / hop;
+            node_inv[v] += found * hop / lvl;
+            node_reached[v] += found;
+        }
+        counter.swap(next_counter);
+        printf("\b\b\b\b\b\b\b\b\b\b\b\b\b\b\b"); // Progress: one pass per level
+        printf("pass %10d", lvl);
+        if (!changed) break;
+    }
+
+    // Component sizes, for the exact fallback
+    vector<int> component(n, 0);
+    for (int v = 0; v < n; ++v) {
+        if (component[v]) continue;
+        bfs(scan, n, v);
+        for (int u : touched) component[u] = (int)touched.size();
+    }
+
+    dist_sum.resize(sources.size());
+    inv_sum.resize(sources.size());
+    reached.resize(sources.size());
+    size_t exact = 0;
+    for (size_t s = 0; s < sources.size(); ++s) {
+        int v = sources[s];
+        if (component[v] < m || (component[v] > 1 && node_reached[v] == 0)) {
+            bfs(scan, n, v);
+            level_sums(n, v, hop, only_proteins, dist_sum[s], inv_sum[s], reached[s]);
+            ++exact;
+            continue;
         }
+        dist_sum[s] = node_dist[v];
+        inv_sum[s] = node_inv[v];
+        reached[s] = node_reached[v];
     }
-    return max_q_size;
+    printf("\n%zu of %zu sources ran an exact BFS (small component or stalled sketch)", exact, sources.size());
+}
+
+// One copy of the run's profile next to each of its three output files
+void write_profiles(const string& name, const string& representation) {
+    const char* measures[][2] = {{"Farness", "farness"}, {"Closeness", "closeness"}, {"Harmonic", "harmonic"}};
+    for (auto& m : measures)
+        profile.write_json(string("Output/") + m[0] + "/" + name + "." + representation + "." + m[1] + ".profile.json",
+                           "closeness-farness-harmonic", name, representation);
 }
 
-int main() {
+int main(int argc, char* argv[]) {
     ios_base::sync_with_stdio(false);
     cin.tie(NULL);
+
+    Options opts(argc, argv);
+    if (!opts.known({"bipartite-bfs", "clique-view", "hll-log2m", "hyperball", "msbfs", "no-cache", "profile",
+                     "reduce", "reorder", "top-down", "updates"}))
+        return 1;
+    // Parsed datasets are snapshotted to <input>.csr unless --no-cache is given
+    bool use_cache = !opts.has("no-cache");
+    // --clique-view computes the graph results from the hypergraph's implicit
+    // clique expansion instead of reading the materialized .graph file
+    bool clique_view = opts.has("clique-view");
+    // --msbfs runs the bit-parallel multi-source BFS instead of one BFS per source
+    bool use_msbfs = opts.has("msbfs");
+    // --hyperball approximates all three measures from HyperLogLog counters
+    // with 2^--hll-log2m registers per node (relative error about 1.04 / sqrt(2^log2m)).
+    // Each pass costs 2^log2m register maxima per arc, so it only beats the
+    // exact BFS on graphs far larger than CORUM: there it is slower (1.16 s and
+    // a 6 MB heap at --hll-log2m=10 against 0.32 s exact). Sources in small
+    // components fall back to an exact BFS (see hyperball()).
+    bool use_hyperball = opts.has("hyperball");
+    long long requested_log2m = opts.get_int("hll-log2m", 7);
+    int hll_log2m = (int)max(4LL, min(16LL, requested_log2m));
+    if (hll_log2m != requested_log2m)
+        cerr << "WARNING: --hll-log2m must be between 4 and 16; using " << hll_log2m << "." << endl;
+    bool batched = use_msbfs || use_hyperball;
+    // --top-down keeps the queue-based BFS on the .ungraph instead of the
+    // direction-optimizing kernel
+    bool top_down = opts.has("top-down");
+    // --bipartite-bfs runs the generic BFS over the .cmty bipartite graph
+    // instead of the hypergraph traversal
+    bool bipartite_bfs = opts.has("bipartite-bfs");
+    // --reduce collapses duplicate hyperedges and twin proteins of the .cmty
+    // hypergraph and runs one traversal per protein class
+    bool reduce = opts.has("reduce");
+    // --reorder=rcm|gorder|degree renumbers every loaded graph for cache
+    // locality (see vertex-order.h); results keep their original IDs
+    VertexOrder reorder = VertexOrder::NONE;
+    if (opts.has("reorder") && !parse_vertex_order(opts.get("reorder"), reorder)) {
+        cerr << "ERROR: Unknown vertex order '" << opts.get("reorder") << "'" << endl;
+        return 1;
+    }
+    // --updates=<file> applies a batch of hyperedge insertions/deletions after
+    // the first run and reruns only the sources whose distances change
+    HyperedgeBatch batch;
+    if (opts.has("updates") && !read_hyperedge_batch(opts.get("updates"), batch)) return 1;
+    bool dynamic = !batch.empty();
+    if (opts.has("profile")) profile.enable();
+    if (dynamic && clique_view)
+        cout << "INFO: --clique-view has no stored graph to update, so --updates only applies to the hypergraph." << endl;
+    if (dynamic && batched) {
+        cout << "INFO: --updates keeps per-source distances, so it runs one BFS per source." << endl;
+        batched = false;
+    }
+    if (reduce && (dynamic || batched || bipartite_bfs)) {
+        cout << "INFO: --reduce needs one hypergraph traversal per source; ignoring it with --updates, "
+             << "--msbfs, --hyperball or --bipartite-bfs." << endl;
+        reduce = false;
+    }
     
     // --- User Info: Ensure output directories exist ---
     cout << "INFO: This script saves results to the following directories:" << endl;
@@ -90,7 +434,6 @@ int main() {
     cout << "INFO: Please ensure these directories exist before running." << endl;
 
     ifstream fin;
-    ofstream fout;
 
     // --- Read dataset configurations from dataset_init.txt (using relative path) ---
     for (const auto& s : init) {
@@ -118,179 +461,304 @@ int main() {
         //  Part 1: Standard Graph Representation
         // ===================================================================
         {
+            profile.reset();
+            const MemoryPhases& phases = profile.memory;
             auto begin = chrono::high_resolution_clock::now();
-            fin.open(graphs[i]);
-            int nodes, edges;
-            fin >> nodes >> edges;
-
-            for (int j = 0; j < MAXN + MAXHE; ++j) graph[j].clear();
-            idx_to_node.clear();
-            node_to_idx.clear();
-            
-            int u, v, cnt = 0;
-            while (fin >> u >> v) {
-                if (node_to_idx.find(u) == node_to_idx.end()) { idx_to_node[cnt] = u; node_to_idx[u] = cnt++; }
-                u = node_to_idx[u];
-                if (node_to_idx.find(v) == node_to_idx.end()) { idx_to_node[cnt] = v; node_to_idx[v] = cnt++; }
-                v = node_to_idx[v];
-                graph[u].push_back(v);
-                graph[v].push_back(u);
-            }
-            fin.close();
+            profile.begin("load");
+            if (clique_view)
+                load_clique_view(hypergraphs[i], MAXN, use_cache, ids, clique);
+            else
+                load_dataset(graphs[i], -1, use_cache, ids, graph, protein);
+            profile.begin("build");
+            // The clique view is built from the hypergraph and keeps its numbering
+            if (!clique_view)
+                cout << reorder_dataset(reorder, ids, graph, protein).report();
+            int cnt = ids.size();
+            CSRGraph::Scanner graph_scan(graph);
+            CliqueView::Scanner clique_scan(clique);
+            direction_optimizing = !clique_view && !top_down;
+            hypergraph_traversal = false;
             
             farness.assign(cnt, 0);
             closeness.assign(cnt, 0);
             harmonic.assign(cnt, 0);
 
-            int mem_q = 0, j = 0;
-            for (int k = 0; k < cnt; ++k) {
-                printf("\b\b\b\b\b\b\b\b\b\b\b\b\b\b\b"); // Progress bar
-                printf("%3.6lf%% done", (double)(++j) / cnt * 100);
-
-                mem_q = max(mem_q, bfs(k));
-                
-                double farness_sum = 0;
-                double harmonic_sum = 0;
-                for (int l = 0; l < cnt; ++l) {
-                    if (visited[l] && k != l) {
-                        farness_sum += level[l];
-                        harmonic_sum += 1.0 / level[l];
-                    }
+            int j = 0;
+            vector<int> sources(cnt);
+            for (int k = 0; k < cnt; ++k) sources[k] = k;
+            vector<double> farness_sum, harmonic_sum, reachable_count;
+            // The clique view has no stored edges to update
+            bool update_graph = dynamic && !clique_view;
+            SourceDistances dist;
+            // Which pairs disappear depends on the other complexes, so the
+            // batch is translated against the hypergraph
+            IdMap hyper_ids;
+            CSRGraph hyper;
+            vector<char> hyper_protein;
+            if (update_graph) {
+                load_dataset(hypergraphs[i], MAXN, use_cache, hyper_ids, hyper, hyper_protein);
+                dist.watch(batch_nodes(hyper, hyper_ids, MAXN, batch, ids));
+            }
+            if (batched) {
+                profile.begin("compute");
+                auto run = [&](auto& scan) {
+                    Profiler::Scope scope(profile, profile.kernel(use_hyperball ? "hyperball" : "msbfs"));
+                    if (use_hyperball)
+                        hyperball(scan, cnt, sources, 1, false, farness_sum, harmonic_sum, reachable_count, hll_log2m);
+                    else
+                        msbfs(scan, cnt, sources, 1, false, farness_sum, harmonic_sum, reachable_count);
+                };
+                if (clique_view) run(clique_scan);
+                else run(graph_scan);
+            } else {
+                farness_sum.assign(cnt, 0);
+                harmonic_sum.assign(cnt, 0);
+                reachable_count.assign(cnt, 0);
+                if (update_graph) dist.resize(cnt);
+                profile.begin("compute");
+            }
+            Profiler::Kernel& bfs_kernel = profile.kernel("bfs");
+            Profiler::Kernel& sums_kernel = profile.kernel("level_sums");
+            Profiler::Kernel& progress_kernel = profile.kernel("progress");
+            for (int k = 0; k < cnt && !batched; ++k) {
+                {
+                    Profiler::Scope scope(profile, progress_kernel);
+                    printf("\b\b\b\b\b\b\b\b\b\b\b\b\b\b\b"); // Progress bar
+                    printf("%3.6lf%% done", (double)(++j) / cnt * 100);
                 }
-                
-                // Normalization by number of reachable nodes in the component
-                int reachable_count = visited.count() - 1;
-                farness[k] = (reachable_count > 0) ? farness_sum / reachable_count : 0;
-                closeness[k] = (farness[k] > 0) ? 1.0 / farness[k] : 0;
-                
-                // Normalization by total number of nodes in graph
-                harmonic[k] = (cnt > 1) ? harmonic_sum / (cnt - 1) : 0;
+                {
+                    Profiler::Scope scope(profile, bfs_kernel);
+                    if (clique_view) bfs(clique_scan, cnt, k);
+                    else if (direction_optimizing) bfs_direction(k);
+                    else bfs(graph_scan, cnt, k);
+                }
+                Profiler::Scope scope(profile, sums_kernel);
+                level_sums(cnt, k, 1, false, farness_sum[k], harmonic_sum[k], reachable_count[k],
+                           update_graph ? &dist : nullptr);
             }
             cout << endl;
 
-            unsigned long long memory = mem_q * sizeof(int);
-            memory += getMemoryUsage(idx_to_node) + getMemoryUsage(node_to_idx);
-            memory += getMemoryUsage2(cnt) + getMemoryUsage3(level);
-            
+            size_t rerun = 0;
+            double update_time = 0;
+            int live = cnt;
+            if (update_graph) {
+                auto update_begin = chrono::high_resolution_clock::now();
+                GraphChanges changes;
+                clique_changes(hyper, hyper_ids, MAXN, batch, ids, changes);
+                Profiler::Scope scope(profile, profile.kernel("update"));
+                rerun = update_sums(changes, sources, 1, false, dist, farness_sum, harmonic_sum, reachable_count);
+                cnt = ids.size();
+                live = 0;
+                for (int k = 0; k < cnt; ++k) live += graph.degree(k) > 0;
+                update_time = chrono::duration_cast<chrono::duration<double>>(chrono::high_resolution_clock::now() - update_begin).count();
+            }
+
+            // Farness is normalized by the number of reachable nodes in the
+            // component, harmonic by the total number of nodes in the graph
+            farness.assign(cnt, 0);
+            closeness.assign(cnt, 0);
+            harmonic.assign(cnt, 0);
+            for (size_t s = 0; s < sources.size(); ++s) {
+                int k = sources[s];
+                farness[k] = (reachable_count[s] > 0) ? farness_sum[s] / reachable_count[s] : 0;
+                closeness[k] = (farness[k] > 0) ? 1.0 / farness[k] : 0;
+                harmonic[k] = (live > 1) ? harmonic_sum[s] / (live - 1) : 0;
+            }
+
             auto end = chrono::high_resolution_clock::now();
             double time = chrono::duration_cast<chrono::duration<double>>(end-begin).count();
+            profile.begin("output");
+            unsigned long long memory = phases.heap_peak(), rss = phases.rss_peak();
 
             cout << "For graph representation:" << endl;
+            cout << "Memory Used: " << memory << " Bytes (peak RSS " << rss << " Bytes)" << endl;
             cout << "Time Taken: " << fixed << setprecision(6) << time << " Seconds" << endl;
+            if (update_graph)
+                cout << "Incremental update: +" << batch.inserted.size() << " -" << batch.deleted.size()
+                     << " hyperedges, " << rerun << " of " << sources.size() << " sources rerun in " << update_time
+                     << " Seconds" << endl;
 
             // --- Write Output Files ---
-            fout.open("Output/Farness/" + names[i] + ".ungraph.farness.txt");
-            fout << memory + getMemoryUsage3(farness) << " " << fixed << setprecision(9) << time << endl << endl;
-            for (const auto& pair : node_to_idx) fout << pair.first << " " << farness[pair.second] << endl;
-            fout.close();
-
-            fout.open("Output/Closeness/" + names[i] + ".ungraph.closeness.txt");
-            fout << memory + getMemoryUsage3(closeness) << " " << fixed << setprecision(9) << time << endl << endl;
-            for (const auto& pair : node_to_idx) fout << pair.first << " " << closeness[pair.second] << endl;
-            fout.close();
-
-            fout.open("Output/Harmonic/" + names[i] + ".ungraph.harmonic.txt");
-            fout << memory + getMemoryUsage3(harmonic) << " " << fixed << setprecision(9) << time << endl << endl;
-            for (const auto& pair : node_to_idx) fout << pair.first << " " << harmonic[pair.second] << endl;
-            fout.close();
+            ResultWriter out;
+            out.field(memory).field(time).field(rss).end_line().end_line();
+            for (int j : ids.sorted_indices())
+                if (!update_graph || graph.degree(j) > 0) out.row(ids[j], farness[j]);
+            out.save("Output/Farness/" + names[i] + ".ungraph.farness.txt");
+
+            out = ResultWriter();
+            out.field(memory).field(time).field(rss).end_line().end_line();
+            for (int j : ids.sorted_indices())
+                if (!update_graph || graph.degree(j) > 0) out.row(ids[j], closeness[j]);
+            out.save("Output/Closeness/" + names[i] + ".ungraph.closeness.txt");
+
+            out = ResultWriter();
+            out.field(memory).field(time).field(rss).end_line().end_line();
+            for (int j : ids.sorted_indices())
+                if (!update_graph || graph.degree(j) > 0) out.row(ids[j], harmonic[j]);
+            out.save("Output/Harmonic/" + names[i] + ".ungraph.harmonic.txt");
 
             // Find and print max nodes for each centrality
             // ... (code for finding and printing max nodes is correct and retained)
-            cout << endl;
+            profile.end();
+            cout << "Memory by phase:" << endl << phases.report() << endl;
+            if (profile.enabled()) write_profiles(names[i], "ungraph");
+            // Release the graph so the hypergraph run is measured on its own
+            clique = CliqueView();
+            graph = CSRGraph();
+            ids = IdMap();
+            protein = vector<char>();
         }
 
         // ===================================================================
         //  Part 2: Hypergraph Representation
         // ===================================================================
         {
+            profile.reset();
+            const MemoryPhases& phases = profile.memory;
             auto begin = chrono::high_resolution_clock::now();
-            fin.open(hypergraphs[i]);
-            
-            for (int j = 0; j < MAXN + MAXHE; ++j) graph[j].clear();
-            idx_to_node.clear();
-            node_to_idx.clear();
+            profile.begin("load");
+            int hyperEdge_count = load_dataset(hypergraphs[i], MAXN, use_cache, ids, graph, protein);
+            profile.begin("build");
+            cout << reorder_dataset(reorder, ids, graph, protein).report();
+            int cnt = ids.size();
             mask.reset();
+            for (int j = 0; j < cnt; ++j)
+                if (protein[j]) mask.set(j);
+            // The bipartite graph has no dense cliques for bottom-up steps
+            // to skip, so it keeps the top-down kernel
+            direction_optimizing = false;
+            hypergraph_traversal = !bipartite_bfs;
 
-            string line;
-            int u, v, cnt = 0;
-            int hyperEdge_count = 0;
-            while(getline(fin, line)) {
-                if (line.empty()) continue;
-                stringstream buffer(line);
-                v = MAXN + hyperEdge_count;
-                if (node_to_idx.find(v) == node_to_idx.end()) { idx_to_node[cnt] = v; node_to_idx[v] = cnt++; }
-                v = node_to_idx[v];
-                while(buffer >> u) {
-                    if (node_to_idx.find(u) == node_to_idx.end()) { idx_to_node[cnt] = u; node_to_idx[u] = cnt++; }
-                    u = node_to_idx[u];
-                    mask.set(u);
-                    graph[u].push_back(v);
-                    graph[v].push_back(u);
+            int protein_node_count = (cnt - hyperEdge_count);
+            CSRGraph::Scanner graph_scan(graph);
+            int j = 0;
+            // Only original protein nodes act as sources
+            vector<int> sources;
+            for (int k = 0; k < cnt; ++k)
+                if (mask[k]) sources.push_back(k);
+            vector<double> farness_sum, harmonic_sum;
+            vector<double> reachable_protein_count;
+            SourceDistances dist;
+            if (!batched) {
+                farness_sum.assign(sources.size(), 0);
+                harmonic_sum.assign(sources.size(), 0);
+                reachable_protein_count.assign(sources.size(), 0);
+                if (dynamic) {
+                    dist.resize(cnt);
+                    dist.watch(batch_nodes(graph, ids, MAXN, batch, ids));
+                }
+            }
+            HypergraphReduction reduction;
+            if (reduce) {
+                reduction.build(graph, protein);
+                cout << "Reduced hypergraph: " << reduction.num_protein_classes() << " protein classes for "
+                     << protein_node_count << " proteins, " << reduction.num_hyperedge_classes()
+                     << " distinct hyperedges of " << hyperEdge_count << ", " << reduction.arcs_removed()
+                     << " incidences removed" << endl;
+            }
+            profile.begin("compute");
+            if (reduce) {
+                Profiler::Scope scope(profile, profile.kernel("reduced_bfs"));
+                reduced_sums(reduction, sources, farness_sum, harmonic_sum, reachable_protein_count);
+            }
+            if (batched) {
+                Profiler::Scope scope(profile, profile.kernel(use_hyperball ? "hyperball" : "msbfs"));
+                if (use_hyperball)
+                    hyperball(graph_scan, cnt, sources, 2, true, farness_sum, harmonic_sum, reachable_protein_count,
+                              hll_log2m);
+                else
+                    msbfs(graph_scan, cnt, sources, 2, true, farness_sum, harmonic_sum, reachable_protein_count);
+            }
+            Profiler::Kernel& bfs_kernel = profile.kernel("bfs");
+            Profiler::Kernel& sums_kernel = profile.kernel("level_sums");
+            Profiler::Kernel& progress_kernel = profile.kernel("progress");
+            for (size_t s = 0; s < sources.size() && !batched && !reduce; ++s) {
+                {
+                    Profiler::Scope scope(profile, progress_kernel);
+                    printf("\b\b\b\b\b\b\b\b\b\b\b\b\b\b\b"); // Progress bar
+                    printf("%3.6lf%% done", (double)(++j) / protein_node_count * 100);
+                }
+                {
+                    Profiler::Scope scope(profile, bfs_kernel);
+                    if (hypergraph_traversal) bfs_hypergraph(cnt, sources[s]);
+                    else bfs(graph_scan, cnt, sources[s]);
                 }
-                hyperEdge_count++;
+                // The distance between two protein nodes in the bipartite graph is twice
+                // the "real" hypergraph distance, so bipartite levels are divided by 2
+                Profiler::Scope scope(profile, sums_kernel);
+                level_sums(cnt, sources[s], hypergraph_traversal ? 1 : 2, true, farness_sum[s], harmonic_sum[s], reachable_protein_count[s],
+                           dynamic ? &dist : nullptr);
+            }
+            cout << endl;
+
+            size_t rerun = 0;
+            double update_time = 0;
+            if (dynamic) {
+                auto update_begin = chrono::high_resolution_clock::now();
+                Profiler::Scope scope(profile, profile.kernel("update"));
+                GraphChanges changes;
+                bipartite_changes(graph, ids, MAXN, hyperEdge_count, batch, changes);
+                for (int k = cnt; k < changes.num_nodes; ++k)
+                    if (ids[k] < MAXN) mask.set(k);
+                rerun = update_sums(changes, sources, 2, true, dist, farness_sum, harmonic_sum,
+                                    reachable_protein_count);
+                cnt = ids.size();
+                protein_node_count = 0;
+                for (int k = 0; k < cnt; ++k)
+                    protein_node_count += mask[k] && graph.degree(k) > 0;
+                update_time = chrono::duration_cast<chrono::duration<double>>(chrono::high_resolution_clock::now() - update_begin).count();
             }
-            fin.close();
 
             farness.assign(cnt, 0);
             closeness.assign(cnt, 0);
             harmonic.assign(cnt, 0);
-            
-            int protein_node_count = (cnt - hyperEdge_count);
-            int mem_q = 0, j = 0;
-            for (int k = 0; k < cnt; ++k) {
-                if (!mask[k]) continue; // Only run BFS from original protein nodes
-
-                printf("\b\b\b\b\b\b\b\b\b\b\b\b\b\b\b"); // Progress bar
-                printf("%3.6lf%% done", (double)(++j) / protein_node_count * 100);
-
-                mem_q = max(mem_q, bfs(k));
-                
-                double farness_sum = 0;
-                double harmonic_sum = 0;
-                for (int l = 0; l < cnt; ++l) {
-                    if (mask[l] && visited[l] && k != l) {
-                        // The distance between two protein nodes in the bipartite graph is twice
-                        // the "real" hypergraph distance. We must divide by 2.
-                        farness_sum += (double)level[l] / 2.0;
-                        harmonic_sum += 2.0 / level[l];
-                    }
-                }
-                
-                int reachable_protein_count = (visited & mask).count() - 1;
-                farness[k] = (reachable_protein_count > 0) ? farness_sum / reachable_protein_count : 0;
+            for (size_t s = 0; s < sources.size(); ++s) {
+                int k = sources[s];
+                farness[k] = (reachable_protein_count[s] > 0) ? farness_sum[s] / reachable_protein_count[s] : 0;
                 closeness[k] = (farness[k] > 0) ? 1.0 / farness[k] : 0;
-                harmonic[k] = (protein_node_count > 1) ? harmonic_sum / (protein_node_count - 1) : 0;
+                harmonic[k] = (protein_node_count > 1) ? harmonic_sum[s] / (protein_node_count - 1) : 0;
             }
-            cout << endl;
-
-            unsigned long long memory = mem_q * sizeof(int);
-            memory += getMemoryUsage(idx_to_node) + getMemoryUsage(node_to_idx);
-            memory += getMemoryUsage2(cnt) + getMemoryUsage3(level);
 
             auto end = chrono::high_resolution_clock::now();
             double time = chrono::duration_cast<chrono::duration<double>>(end-begin).count();
+            profile.begin("output");
+            unsigned long long memory = phases.heap_peak(), rss = phases.rss_peak();
 
             cout << "For hypergraph representation:" << endl;
+            cout << "Memory Used: " << memory << " Bytes (peak RSS " << rss << " Bytes)" << endl;
             cout << "Time Taken: " << fixed << setprecision(6) << time << " Seconds" << endl;
+            if (dynamic)
+                cout << "Incremental update: +" << batch.inserted.size() << " -" << batch.deleted.size()
+                     << " hyperedges, " << rerun << " of " << sources.size() << " sources rerun in " << update_time
+                     << " Seconds" << endl;
 
             // --- Write Output Files ---
-            fout.open("Output/Farness/" + names[i] + ".cmty.farness.txt");
-            fout << memory + getMemoryUsage3(farness) << " " << fixed << setprecision(9) << time << endl << endl;
-            for (const auto& pair : node_to_idx) if (mask[pair.second]) fout << pair.first << " " << farness[pair.second] << endl;
-            fout.close();
-
-            fout.open("Output/Closeness/" + names[i] + ".cmty.closeness.txt");
-            fout << memory + getMemoryUsage3(closeness) << " " << fixed << setprecision(9) << time << endl << endl;
-            for (const auto& pair : node_to_idx) if (mask[pair.second]) fout << pair.first << " " << closeness[pair.second] << endl;
-            fout.close();
-
-            fout.open("Output/Harmonic/" + names[i] + ".cmty.harmonic.txt");
-            fout << memory + getMemoryUsage3(harmonic) << " " << fixed << setprecision(9) << time << endl << endl;
-            for (const auto& pair : node_to_idx) if (mask[pair.second]) fout << pair.first << " " << harmonic[pair.second] << endl;
-            fout.close();
+            ResultWriter out;
+            out.field(memory).field(time).field(rss).end_line().end_line();
+            for (int j : ids.sorted_indices())
+                if (mask[j] && (!dynamic || graph.degree(j) > 0)) out.row(ids[j], farness[j]);
+            out.save("Output/Farness/" + names[i] + ".cmty.farness.txt");
+
+            out = ResultWriter();
+            out.field(memory).field(time).field(rss).end_line().end_line();
+            for (int j : ids.sorted_indices())
+                if (mask[j] && (!dynamic || graph.degree(j) > 0)) out.row(ids[j], closeness[j]);
+            out.save("Output/Closeness/" + names[i] + ".cmty.closeness.txt");
+
+            out = ResultWriter();
+            out.field(memory).field(time).field(rss).end_line().end_line();
+            for (int j : ids.sorted_indices())
+                if (mask[j] && (!dynamic || graph.degree(j) > 0)) out.row(ids[j], harmonic[j]);
+            out.save("Output/Harmonic/" + names[i] + ".cmty.harmonic.txt");
 
             // Find and print max nodes for each centrality
             // ... (code for finding and printing max nodes is correct and retained)
+            profile.end();
+            cout << "Memory by phase:" << endl << phases.report();
+            if (profile.enabled()) write_profiles(names[i], "cmty");
+            graph = CSRGraph();
+            ids = IdMap();
+            protein = vector<char>();
         }
         cout << string(80, '=') << endl;
     }
@@ -0,0 +1,159 @@
+#ifndef CSR_GRAPH_H
+#define CSR_GRAPH_H
+
+#include <vector>
+#include <utility>
+#include <memory>
+
+/*
+ * Compressed-sparse-row adjacency shared by all centrality programs.
+ *
+ * The neighbors of vertex v are adj[offset[v]] .. adj[offset[v + 1] - 1].
+ * The structure is built in one pass over a buffered edge list: count the
+ * degrees, prefix-sum them into offsets, then scatter the endpoints. Edges are
+ * scattered in input order, so every neighbor list comes out in exactly the
+ * order the old per-vertex push_back loaders produced.
+ *
+ * A graph can also be a read-only view over arrays that live elsewhere, such
+ * as a memory-mapped binary snapshot (see graph-cache.h); `backing` keeps that
+ * storage alive for as long as the view exists.
+ */
+class CSRGraph {
+public:
+    // --- Lightweight view so kernels can write `for (int u : g.neighbors(v))` ---
+    struct Range {
+        const int* first;
+        const int* last;
+        const int* begin() const { return first; }
+        const int* end() const { return last; }
+        int size() const { return (int)(last - first); }
+    };
+
+    CSRGraph() = default;
+    CSRGraph(const CSRGraph& other) { *this = other; }
+    CSRGraph(CSRGraph&& other) noexcept { *this = std::move(other); }
+
+    CSRGraph& operator=(const CSRGraph& other) {
+        num_nodes = other.num_nodes;
+        offset = other.offset;
+        adj = other.adj;
+        backing = other.backing;
+        repoint(other);
+        return *this;
+    }
+
+    CSRGraph& operator=(CSRGraph&& other) noexcept {
+        num_nodes = other.num_nodes;
+        offset = std::move(other.offset);
+        adj = std::move(other.adj);
+        backing = std::move(other.backing);
+        repoint(other);
+        other.clear();
+        return *this;
+    }
+
+    // Builds the graph on vertices [0, n) from a list of (u, v) pairs.
+    // Undirected graphs store every edge in both endpoint lists.
+    void build(int n, const std::vector<std::pair<int, int>>& edges, bool undirected = true) {
+        backing.reset();
+        num_nodes = n;
+        offset.assign(n + 1, 0);
+        for (const auto& [u, v] : edges) {
+            ++offset[u + 1];
+            if (undirected) ++offset[v + 1];
+        }
+        for (int i = 0; i < n; ++i)
+            offset[i + 1] += offset[i];
+
+        adj.assign(offset[n], 0);
+        std::vector<long long> pos(offset.begin(), offset.end() - 1);
+        for (const auto& [u, v] : edges) {
+            adj[pos[u]++] = v;
+            if (undirected) adj[pos[v]++] = u;
+        }
+        offset_ptr = offset.data();
+        adj_ptr = adj.data();
+    }
+
+    // The same graph with vertex v renumbered to rank[v] (a permutation of
+    // [0, n)). Neighbor lists keep their order, so kernels scan the
+    // neighbors of a vertex in the same sequence as before.
+    CSRGraph permuted(const std::vector<int>& rank) const {
+        CSRGraph g;
+        int n = num_nodes;
+        std::vector<int> vertex(n);
+        for (int v = 0; v < n; ++v)
+            vertex[rank[v]] = v;
+        g.num_nodes = n;
+        g.offset.assign(n + 1, 0);
+        for (int x = 0; x < n; ++x)
+            g.offset[x + 1] = g.offset[x] + degree(vertex[x]);
+        g.adj.resize(g.offset[n]);
+        for (int x = 0; x < n; ++x) {
+            int* row = g.adj.data() + g.offset[x];
+            for (int u : neighbors(vertex[x]))
+                *row++ = rank[u];
+        }
+        g.offset_ptr = g.offset.data();
+        g.adj_ptr = g.adj.data();
+        return g;
+    }
+
+    // Points the graph at external offset/neighbor arrays owned by `storage`.
+    void attach(std::shared_ptr<const void> storage, int n, const long long* offsets, const int* neighbors) {
+        offset.clear();
+        adj.clear();
+        backing = std::move(storage);
+        num_nodes = n;
+        offset_ptr = offsets;
+        adj_ptr = neighbors;
+    }
+
+    void clear() {
+        backing.reset();
+        num_nodes = 0;
+        offset.assign(1, 0);
+        adj.clear();
+        offset_ptr = offset.data();
+        adj_ptr = adj.data();
+    }
+
+    int size() const { return num_nodes; }
+    long long num_arcs() const { return offset_ptr[num_nodes]; }
+    int degree(int v) const { return (int)(offset_ptr[v + 1] - offset_ptr[v]); }
+    Range neighbors(int v) const { return {adj_ptr + offset_ptr[v], adj_ptr + offset_ptr[v + 1]}; }
+    const long long* offsets() const { return offset_ptr; }
+    const int* adjacency() const { return adj_ptr; }
+
+    // Traversal interface shared with CliqueView (see clique-view.h), so the
+    // kernels can be written once for both. A stored graph needs no state.
+    class Scanner {
+    public:
+        explicit Scanner(const CSRGraph& g) : graph(g) {}
+        void reset() {}
+        template <class F>
+        void neighbors(int v, F f) const { for (int u : graph.neighbors(v)) f(u); }
+        template <class F>
+        void expand(int v, F f) const { neighbors(v, f); }
+
+    private:
+        const CSRGraph& graph;
+    };
+
+private:
+    int num_nodes = 0;
+    std::vector<long long> offset = std::vector<long long>(1, 0);
+    std::vector<int> adj;
+    std::shared_ptr<const void> backing;
+    const long long* offset_ptr = offset.data();
+    const int* adj_ptr = nullptr;
+
+    // After a copy or move, owned graphs point at their own arrays while
+    // views keep pointing into the shared backing storage.
+    void repoint(const CSRGraph& other) {
+        offset_ptr = backing ? other.offset_ptr : offset.data();
+        adj_ptr = backing ? other.adj_ptr : adj.data();
+    }
+};
+
+#endif // CSR_GRAPH_H
@@ -1,15 +1,20 @@
 
 #include <iostream>
 #include <fstream>
-#include <sstream>
 #include <string>
 #include <vector>
-#include <map>
 #include <cmath>
 #include <bitset>
 #include <chrono>
 #include <iomanip>
 #include <algorithm>
+#include "csr-graph.h"
+#include "id-map.h"
+#include "graph-cache.h"
+#include "clique-view.h"
+#include "cli-options.h"
+#include "profiler.h"
+#include "result-writer.h"
 
 using namespace std;
 
@@ -23,34 +28,26 @@ vector<string> names;
 const int MAXN = 4e6;
 const int MAXHE = 3e6;
 const double epsilon = 1e-9;
-vector<int> graph[MAXN + MAXHE];
-map<int, int> idx_to_node;
-map<int, int> node_to_idx;
+CSRGraph graph;
+CliqueView clique;
+vector<char> protein;
+IdMap ids;
 vector<double> degree_centrality; // Changed from 'betweenness'
 bitset<MAXN + MAXHE> mask;
+// --profile times phases and kernels and writes <output>.profile.json
+Profiler profile;
+
+int main(int argc, char* argv[]){
+    Options opts(argc, argv);
+    if (!opts.known({"clique-view", "no-cache", "profile"}))
+        return 1;
+    // Parsed datasets are snapshotted to <input>.csr unless --no-cache is given
+    bool use_cache = !opts.has("no-cache");
+    // --clique-view computes the graph results from the hypergraph's implicit
+    // clique expansion instead of reading the materialized .graph file
+    bool clique_view = opts.has("clique-view");
+    if (opts.has("profile")) profile.enable();
 
-// --- Memory Calculation Utilities (from original betweenness code) ---
-template<class K, class V>
-unsigned long long getMemoryUsage(const map<K, V>& m) {
-    unsigned long long nodeSize = sizeof(K) + sizeof(V) + 3 * sizeof(void*) + sizeof(bool);
-    unsigned long long adminSize = 3 * sizeof(void*) + sizeof(size_t);
-    return adminSize + m.size() * nodeSize;
-}
-
-unsigned long long getMemoryUsage2(vector<int> g[], int cnt) {
-    unsigned long long totalSize = 0;
-    for (int i = 0; i < cnt; ++i)
-        totalSize += g[i].size() * sizeof(int);
-    return totalSize;
-}
-
-template<class T>
-unsigned long long getMemoryUsage3(const vector<T>& v, unsigned long long cnt) {
-    return cnt * sizeof(v[0]);
-}
-
-
-int main(){
     string output_dir_name = "Output/Degree/";
     cout << "INFO: Ensure the output directory '" << output_dir_name << "' exists." << endl;
 
@@ -58,7 +55,6 @@ int main(){
     cin.tie(NULL);
 
     ifstream fin;
-    ofstream fout;
 
     // --- Read dataset configurations (from original betweenness code) ---
     for (auto& s: init){
@@ -82,54 +78,45 @@ int main(){
         //  Part 1: Standard Graph Representation
         // ===================================================================
         {
+            profile.reset();
+            const MemoryPhases& phases = profile.memory;
             auto begin = chrono::high_resolution_clock::now();
-            fin.open(graphs[i]);
-            int nodes, edges;
-            fin >> nodes >> edges;
-
             // --- Data loading structure (from original betweenness code) ---
-            for (int j = 0; j < MAXN + MAXHE; ++j) graph[j].clear();
-            idx_to_node.clear();
-            node_to_idx.clear();
-            int u, v, cnt = 0;
-            while(fin >> u >> v){
-                if(node_to_idx.find(u) == node_to_idx.end()){ idx_to_node[cnt] = u; node_to_idx[u] = cnt++; }
-                u = node_to_idx[u];
-                if(node_to_idx.find(v) == node_to_idx.end()){ idx_to_node[cnt] = v; node_to_idx[v] = cnt++; }
-                v = node_to_idx[v];
-                graph[u].push_back(v);
-                graph[v].push_back(u);
-            }
-            fin.close();
+            profile.begin("load");
+            if (clique_view)
+                load_clique_view(hypergraphs[i], MAXN, use_cache, ids, clique);
+            else
+                load_dataset(graphs[i], -1, use_cache, ids, graph, protein);
+            profile.begin("build");
+            int cnt = ids.size();
 
             // --- THIS IS THE CORE LOGIC FROM YOUR GROUPMATE'S NEW CODE ---
             // It replaces the entire complex 'solve()' function and loop.
             degree_centrality.assign(cnt, 0);
-            for(int j = 0; j < cnt; ++j) {
-                degree_centrality[j] = graph[j].size();
+            profile.begin("compute");
+            {
+                Profiler::Scope scope(profile, profile.kernel("degree"));
+                for(int j = 0; j < cnt; ++j) {
+                    degree_centrality[j] = clique_view ? clique.degree(j) : graph.degree(j);
+                }
             }
             printf("Degree centrality calculated for graph.\n");
 
             // --- Performance tracking and output formatting (from original betweenness code) ---
-            unsigned long long memory = 0;
-            memory += getMemoryUsage(idx_to_node);
-            memory += getMemoryUsage(node_to_idx);
-            memory += getMemoryUsage2(graph, cnt);
-            memory += getMemoryUsage3(degree_centrality, cnt);
-
+            profile.begin("output");
             printf("For graph representation:\n");
-            printf("Memory Used: %llu Bytes\n", memory);
+            printf("Memory Used: %llu Bytes (peak RSS %llu Bytes)\n", phases.heap_peak(), phases.rss_peak());
             auto end = chrono::high_resolution_clock::now();
             double time = chrono::duration_cast<chrono::duration<double>>(end-begin).count();
             printf("Time Taken: %lf Seconds\n", time);
 
             string out_fname = output_dir_name + names[i] + ".ungraph.degree.txt";
-            fout.open(out_fname);
-            fout << memory << " " << fixed << setprecision(9) << time << endl << endl;
-            for (auto const& [node_id, index] : node_to_idx) {
-                fout << node_id << " " << degree_centrality[index] << endl;
+            ResultWriter out;
+            out.field(phases.heap_peak()).field(time).field(phases.rss_peak()).end_line().end_line();
+            for (int index : ids.sorted_indices()) {
+                out.row(ids[index], degree_centrality[index]);
             }
-            fout.close();
+            out.save(out_fname);
 
             double max_degree = 0;
             if(!degree_centrality.empty()) max_degree = *max_element(degree_centrality.begin(), degree_centrality.end());
@@ -138,75 +125,68 @@ int main(){
             bool first = true;
             for (int j = 0; j < cnt; ++j) {
                 if (fabs(max_degree - degree_centrality[j]) < epsilon) {
-                    if (!first) printf(", "); printf("%d", idx_to_node[j]); first = false;
+                    if (!first) printf(", "); printf("%d", ids[j]); first = false;
                 }
             }
-            printf(" (Degree: %.0f).\n\n", max_degree);
+            printf(" (Degree: %.0f).\n", max_degree);
+            profile.end();
+            printf("Memory by phase:\n%s\n", phases.report().c_str());
+            if (profile.enabled())
+                profile.write_json(out_fname.substr(0, out_fname.size() - 4) + ".profile.json", "degree", names[i],
+                                   "ungraph");
+            // Release the graph so the hypergraph run is measured on its own
+            clique = CliqueView();
+            graph = CSRGraph();
+            ids = IdMap();
+            protein = vector<char>();
+            degree_centrality = vector<double>();
         }
 
         // ===================================================================
         //  Part 2: Hypergraph Representation
         // ===================================================================
         {
+            profile.reset();
+            const MemoryPhases& phases = profile.memory;
             auto begin = chrono::high_resolution_clock::now();
-            fin.open(hypergraphs[i]);
-
             // --- Bipartite graph loading structure (from original betweenness code) ---
-            for (int j = 0; j < MAXN + MAXHE; ++j) graph[j].clear();
-            idx_to_node.clear();
-            node_to_idx.clear();
+            profile.begin("load");
+            load_dataset(hypergraphs[i], MAXN, use_cache, ids, graph, protein);
+            profile.begin("build");
+            int cnt = ids.size();
             mask.reset();
-
-            string line;
-            int u, v, cnt = 0;
-            int hyperEdge_count = 0;
-            while(getline(fin, line)){
-                if (line.empty()) continue;
-                stringstream buffer(line);
-                v = MAXN + hyperEdge_count;
-                if(node_to_idx.find(v) == node_to_idx.end()){ idx_to_node[cnt] = v; node_to_idx[v] = cnt++; }
-                v = node_to_idx[v];
-                while(buffer >> u){
-                    if(node_to_idx.find(u) == node_to_idx.end()){ idx_to_node[cnt] = u; node_to_idx[u] = cnt++; }
-                    u = node_to_idx[u];
-                    mask.set(u);
-                    graph[u].push_back(v);
-                    graph[v].push_back(u);
-                }
-                hyperEdge_count++;
-            }
-            fin.close();
+            for (int j = 0; j < cnt; ++j)
+                if (protein[j]) mask.set(j);
 
             // --- CORE LOGIC for hypergraph degree ---
             // Again, a simple loop replaces the complex betweenness calculation.
             degree_centrality.assign(cnt, 0);
-            for(int j = 0; j < cnt; ++j) {
-                degree_centrality[j] = graph[j].size();
+            profile.begin("compute");
+            {
+                Profiler::Scope scope(profile, profile.kernel("degree"));
+                for(int j = 0; j < cnt; ++j) {
+                    degree_centrality[j] = graph.degree(j);
+                }
             }
             printf("Degree centrality calculated for hypergraph (bipartite model).\n");
 
             // --- Performance tracking and output formatting (from original betweenness code) ---
-            unsigned long long memory = 0;
-            memory += getMemoryUsage(idx_to_node);
-            memory += getMemoryUsage(node_to_idx);
-            memory += getMemoryUsage2(graph, cnt);
-            memory += getMemoryUsage3(degree_centrality, cnt);
-
+            profile.begin("output");
             printf("For hypergraph representation:\n");
-            printf("Memory Used: %llu Bytes\n", memory);
+            printf("Memory Used: %llu Bytes (peak RSS %llu Bytes)\n", phases.heap_peak(), phases.rss_peak());
             auto end = chrono::high_resolution_clock::now();
             double time = chrono::duration_cast<chrono::duration<double>>(end-begin).count();
             printf("Time Taken: %lf Seconds\n", time);
             
             string out_fname = output_dir_name + names[i] + ".cmty.degree.txt";
-            fout.open(out_fname);
-            fout << memory << " " << fixed << setprecision(9) << time << endl << endl;
-            for (auto const& [node_id, index] : node_to_idx) {
+            ResultWriter out;
+            out.field(phases.heap_peak()).field(time).field(phases.rss_peak()).end_line().end_line();
+            for (int index : ids.sorted_indices()) {
                 if (mask[index]) { // Only output protein nodes
-                    fout << node_id << " " << degree_centrality[index] << endl;
+                    out.row(ids[index], degree_centrality[index]);
                 }
             }
-            fout.close();
+            out.save(out_fname);
             
             double max_degree = 0;
             for (int j = 0; j < cnt; ++j) if (mask[j]) max_degree = max(max_degree, degree_centrality[j]);
@@ -215,10 +195,19 @@ int main(){
             bool first = true;
             for (int j = 0; j < cnt; ++j) {
               if (mask[j] && fabs(max_degree - degree_centrality[j]) < epsilon) {
-                    if (!first) printf(", "); printf("%d", idx_to_node[j]); first = false;
+                    if (!first) printf(", "); printf("%d", ids[j]); first = false;
               }
             }
             printf(" (Degree: %.0f).\n", max_degree);
+            profile.end();
+            printf("Memory by phase:\n%s", phases.report().c_str());
+            if (profile.enabled())
+                profile.write_json(out_fname.substr(0, out_fname.size() - 4) + ".profile.json", "degree", names[i],
+                                   "cmty");
+            graph = CSRGraph();
+            ids = IdMap();
+            protein = vector<char>();
+            degree_centrality = vector<double>();
         }
 
         printf("%s\n", string(80, '=').c_str());
@@ -0,0 +1,107 @@
+#ifndef DIRECTION_BFS_H
+#define DIRECTION_BFS_H
+
+#include <cstdint>
+#include <vector>
+#include "csr-graph.h"
+#include "visit-marks.h"
+
+/*
+ * Direction-optimizing breadth-first search over a stored undirected graph.
+ *
+ * The search runs level by level. A top-down step scans the neighbor lists of
+ * the frontier, as the queue-based kernels do. Once the frontier gets large,
+ * most of those edges lead back into vertices that are already reached, so a
+ * bottom-up step scans the unreached vertices instead and looks for a neighbor
+ * in the frontier, which is held in a bitmap for that check. Bottom-up relies
+ * on every edge being stored in both endpoint lists.
+ *
+ *   - Distances only: a bottom-up vertex stops at the first frontier neighbor.
+ *     A step goes bottom-up once the frontier's edges exceed 1/alpha of the
+ *     edges of unreached vertices, and back to top-down once the frontier
+ *     holds fewer than 1/beta of the vertices.
+ *   - With `all_parents` (shortest-path counting), every frontier neighbor is
+ *     a parent, so bottom-up cannot stop early; each step takes whichever
+ *     direction scans fewer edges.
+ *
+ * Reached vertices end up in `order` level by level (the source first) with
+ * their BFS level in `level`; levels of vertices outside `order` are stale.
+ * discover(v) runs once when v is reached, before any parent(u, v) call;
+ * parent(u, v) runs for every edge u -> v of the shortest-path DAG when
+ * `all_parents` is set.
+ */
+class DirectionBFS {
+public:
+    int alpha = 14;
+    int beta = 24;
+
+    template <class Discover, class Parent>
+    void run(const CSRGraph& g, int source, VisitMarks& visited, std::vector<int>& order, std::vector<int>& level,
+             bool all_parents, Discover&& discover, Parent&& parent) {
+        int n = g.size();
+        visited.resize(n);
+        if ((int)level.size() < n) level.resize(n);
+        if (frontier.size() < words(n)) frontier.resize(words(n), 0);
+        visited.clear();
+        order.clear();
+
+        visited.mark(source);
+        level[source] = 0;
+        order.push_back(source);
+        discover(source);
+        long long frontier_arcs = g.degree(source);
+        long long unexplored_arcs = g.num_arcs() - frontier_arcs;
+        bool bottom_up = false;
+        for (size_t lo = 0, hi; lo < order.size(); lo = hi) {
+            hi = order.size();
+            long long frontier_size = hi - lo;
+            if (all_parents)
+                bottom_up = frontier_arcs > unexplored_arcs + n;
+            else if (!bottom_up)
+                bottom_up = frontier_arcs * alpha > unexplored_arcs;
+            else
+                bottom_up = frontier_size * beta >= n;
+
+            int next_level = level[order[lo]] + 1;
+            frontier_arcs = 0;
+            auto reach = [&](int v) {
+                level[v] = next_level;
+                order.push_back(v);
+                discover(v);
+                frontier_arcs += g.degree(v);
+            };
+            if (!bottom_up) {
+                for (size_t i = lo; i < hi; ++i) {
+                    int u = order[i];
+                    for (int v : g.neighbors(u)) {
+                        if (visited.mark(v)) reach(v);
+                        if (all_parents && level[v] == next_level) parent(u, v);
+                    }
+                }
+            } else {
+                for (size_t i = lo; i < hi; ++i) set(order[i]);
+                for (int v = 0; v < n; ++v) {
+                    if (visited.marked(v)) continue;
+                    for (int u : g.neighbors(v)) {
+                        if (!test(u)) continue;
+                        if (visited.mark(v)) reach(v);
+                        if (!all_parents) break;
+                        parent(u, v);
+                    }
+                }
+                for (size_t i = lo; i < hi; ++i) unset(order[i]);
+            }
+            unexplored_arcs -= frontier_arcs;
+        }
+    }
+
+private:
+    std::vector<uint64_t> frontier;     // bitmap of the current level, all zero between steps
+
+    static size_t words(int n) { return ((size_t)n + 63) / 64; }
+    void set(int v) { frontier[v >> 6] |= 1ull << (v & 63); }
+    void unset(int v) { frontier[v >> 6] &= ~(1ull << (v & 63)); }
+    bool test(int v) const { return (frontier[v >> 6] >> (v & 63)) & 1; }
+};
+
+#endif // DIRECTION_BFS_H
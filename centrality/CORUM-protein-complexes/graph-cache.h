@@ -0,0 +1,222 @@
+#ifndef GRAPH_CACHE_H
+#define GRAPH_CACHE_H
+
+#include <cstdio>
+#include <cstdint>
+#include <cstring>
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <memory>
+#include <filesystem>
+#include "csr-graph.h"
+#include "id-map.h"
+#include "graph-reader.h"
+
+/*
+ * Binary CSR snapshots for instant startup on repeated runs.
+ *
+ * The first time a dataset is loaded, its parsed form is written next to the
+ * input as "<input>.csr":
+ *
+ *   CacheHeader | ID table (int32 x nodes) | offsets (int64 x nodes+1)
+ *               | neighbors (int32 x arcs) | mask (uint8 x nodes)
+ *
+ * Later runs map that file and point the CSRGraph straight at it, so startup
+ * cost no longer grows with the size of the text input. The header records the
+ * size, modification time and a checksum of the source file: if size and mtime
+ * still match the snapshot is used as is, otherwise the checksum decides whether
+ * the text really changed (e.g. a fresh checkout) or the cache is stale.
+ */
+
+const char CACHE_MAGIC[8] = {'C', 'S', 'R', 'C', 'A', 'C', 'H', 'E'};
+const uint32_t CACHE_VERSION = 1;
+
+struct CacheHeader {
+    char magic[8];
+    uint32_t version;
+    int32_t hyperedge_base;     // -1 for a plain graph
+    int32_t num_nodes;
+    int32_t hyperedges;
+    int64_t num_arcs;
+    uint64_t source_size;
+    int64_t source_mtime;
+    uint64_t source_checksum;
+    uint64_t ids_offset;
+    uint64_t offsets_offset;
+    uint64_t adj_offset;
+    uint64_t mask_offset;
+};
+
+// FNV-1a over 8-byte words (plus the tail bytes) of a file's contents.
+inline uint64_t file_checksum(const std::string& path) {
+    MappedFile file;
+    if (!file.open(path)) return 0;
+    uint64_t hash = 1469598103934665603ull;
+    const char* p = file.data();
+    size_t words = file.size() / 8;
+    for (size_t i = 0; i < words; ++i) {
+        uint64_t word;
+        memcpy(&word, p + i * 8, 8);
+        hash = (hash ^ word) * 1099511628211ull;
+    }
+    for (size_t i = words * 8; i < file.size(); ++i)
+        hash = (hash ^ (unsigned char)p[i]) * 1099511628211ull;
+    return hash;
+}
+
+inline bool source_stat(const std::string& path, uint64_t& size, int64_t& mtime) {
+    std::error_code ec;
+    size = std::filesystem::file_size(path, ec);
+    if (ec) return false;
+    mtime = (int64_t)std::filesystem::last_write_time(path, ec).time_since_epoch().count();
+    return !ec;
+}
+
+inline uint64_t align8(uint64_t x) { return (x + 7) & ~7ull; }
+
+// Writes the snapshot to a temporary file and renames it into place, so a
+// crashed run never leaves a truncated cache behind. The temporary name
+// carries the process ID, so two programs caching the same dataset at once
+// never write into each other's file.
+inline bool write_graph_cache(const std::string& cache_path, const std::string& source_path, int hyperedge_base,
+                              int hyperedges, const IdMap& ids, const CSRGraph& graph,
+                              const std::vector<char>& mask) {
+    CacheHeader h;
+    memset(&h, 0, sizeof(h));
+    memcpy(h.magic, CACHE_MAGIC, sizeof(h.magic));
+    h.version = CACHE_VERSION;
+    h.hyperedge_base = hyperedge_base;
+    h.num_nodes = graph.size();
+    h.hyperedges = hyperedges;
+    h.num_arcs = graph.num_arcs();
+    if (!source_stat(source_path, h.source_size, h.source_mtime)) return false;
+    h.source_checksum = file_checksum(source_path);
+    h.ids_offset = align8(sizeof(CacheHeader));
+    h.offsets_offset = align8(h.ids_offset + (uint64_t)h.num_nodes * sizeof(int32_t));
+    h.adj_offset = align8(h.offsets_offset + ((uint64_t)h.num_nodes + 1) * sizeof(int64_t));
+    h.mask_offset = align8(h.adj_offset + (uint64_t)h.num_arcs * sizeof(int32_t));
+
+#ifdef _WIN32
+    unsigned long pid = GetCurrentProcessId();
+#else
+    unsigned long pid = (unsigned long)getpid();
+#endif
+    std::string tmp_path = cache_path + "." + std::to_string(pid) + ".tmp";
+    FILE* out = fopen(tmp_path.c_str(), "wb");
+    if (!out) return false;
+    bool ok = true;
+    auto put = [&](uint64_t at, const void* data, size_t bytes) {
+        static const char zeros[8] = {0};
+        long pos = ftell(out);
+        if (pos >= 0 && (uint64_t)pos < at) ok = ok && fwrite(zeros, 1, at - pos, out) == at - pos;
+        if (bytes) ok = ok && fwrite(data, 1, bytes, out) == bytes;
+    };
+    put(0, &h, sizeof(h));
+    put(h.ids_offset, ids.nodes().data(), (size_t)h.num_nodes * sizeof(int32_t));
+    put(h.offsets_offset, graph.offsets(), ((size_t)h.num_nodes + 1) * sizeof(int64_t));
+    put(h.adj_offset, graph.adjacency(), (size_t)h.num_arcs * sizeof(int32_t));
+    put(h.mask_offset, mask.data(), (size_t)h.num_nodes);
+    ok = (fclose(out) == 0) && ok;
+
+    std::error_code ec;
+    if (ok) std::filesystem::rename(tmp_path, cache_path, ec);
+    if (!ok || ec) {
+        std::filesystem::remove(tmp_path, ec);
+        return false;
+    }
+    return true;
+}
+
+// Whether the sections of `h` lie in order inside a file of `size` bytes and
+// the CSR arrays they hold are well formed: offsets start at 0, never
+// decrease and end at num_arcs, and every neighbor is a node. A snapshot
+// that fails is rebuilt from the text instead of being read out of bounds.
+inline bool valid_graph_cache(const CacheHeader& h, const char* base, uint64_t size) {
+    if (h.num_nodes < 0 || h.num_arcs < 0 || (uint64_t)h.num_arcs > size) return false;
+    uint64_t n = (uint64_t)h.num_nodes, m = (uint64_t)h.num_arcs;
+    if (h.ids_offset > size || h.offsets_offset > size || h.adj_offset > size || h.mask_offset > size) return false;
+    if (h.ids_offset < sizeof(CacheHeader) || h.offsets_offset % 8 != 0 || h.adj_offset % 4 != 0 ||
+        h.offsets_offset < h.ids_offset + n * sizeof(int32_t) ||
+        h.adj_offset < h.offsets_offset + (n + 1) * sizeof(int64_t) ||
+        h.mask_offset < h.adj_offset + m * sizeof(int32_t) || h.mask_offset + n > size)
+        return false;
+    const int64_t* offsets = (const int64_t*)(base + h.offsets_offset);
+    if (offsets[0] != 0 || offsets[n] != h.num_arcs) return false;
+    for (uint64_t v = 0; v < n; ++v)
+        if (offsets[v + 1] < offsets[v]) return false;
+    const int32_t* adj = (const int32_t*)(base + h.adj_offset);
+    for (uint64_t k = 0; k < m; ++k)
+        if (adj[k] < 0 || adj[k] >= h.num_nodes) return false;
+    return true;
+}
+
+// Maps a snapshot and attaches `graph` to it. Fails if the file is missing,
+// malformed, built for another hyperedge base, or stale for `source_path`.
+inline bool read_graph_cache(const std::string& cache_path, const std::string& source_path, int hyperedge_base,
+                             int& hyperedges, IdMap& ids, CSRGraph& graph, std::vector<char>& mask) {
+    auto file = std::make_shared<MappedFile>();
+    if (!file->open(cache_path) || file->size() < sizeof(CacheHeader)) return false;
+    CacheHeader h;
+    memcpy(&h, file->data(), sizeof(h));
+    if (memcmp(h.magic, CACHE_MAGIC, sizeof(h.magic)) != 0 || h.version != CACHE_VERSION ||
+        h.hyperedge_base != hyperedge_base || !valid_graph_cache(h, file->data(), file->size()))
+        return false;
+
+    uint64_t size;
+    int64_t mtime;
+    if (!source_stat(source_path, size, mtime) || size != h.source_size) return false;
+    if (mtime != h.source_mtime) {
+        if (file_checksum(source_path) != h.source_checksum) return false;
+        // Same contents under a new timestamp: record it so the next run takes the fast path
+        FILE* out = fopen(cache_path.c_str(), "r+b");
+        if (out) {
+            fseek(out, offsetof(CacheHeader, source_mtime), SEEK_SET);
+            fwrite(&mtime, sizeof(mtime), 1, out);
+            fclose(out);
+        }
+    }
+
+    const char* base = file->data();
+    const int32_t* node_ids = (const int32_t*)(base + h.ids_offset);
+    ids.clear();
+    for (int i = 0; i < h.num_nodes; ++i)
+        ids.intern(node_ids[i]);
+    mask.assign(base + h.mask_offset, base + h.mask_offset + h.num_nodes);
+    hyperedges = h.hyperedges;
+    graph.attach(file, h.num_nodes, (const long long*)(base + h.offsets_offset),
+                 (const int*)(base + h.adj_offset));
+    return true;
+}
+
+// Loads a .graph file (hyperedge_base < 0) or a .hypergraph file in the
+// bipartite model, preferring a fresh "<path>.csr" snapshot and refreshing it
+// otherwise. `mask` marks protein nodes. Returns the number of hyperedges, or
+// -1 if the input cannot be read.
+inline int load_dataset(const std::string& path, int hyperedge_base, bool use_cache, IdMap& ids,
+                        CSRGraph& graph, std::vector<char>& mask) {
+    std::string cache_path = path + ".csr";
+    int hyperedges = 0;
+    if (use_cache && read_graph_cache(cache_path, path, hyperedge_base, hyperedges, ids, graph, mask))
+        return hyperedges;
+
+    std::vector<std::pair<int, int>> edges;
+    ids.clear();
+    if (hyperedge_base < 0) {
+        if (!load_graph_file(path, ids, edges)) return -1;
+    } else {
+        hyperedges = load_hypergraph_file(path, hyperedge_base, ids, edges);
+        if (hyperedges < 0) return -1;
+    }
+    graph.build(ids.size(), edges);
+    mask.assign(ids.size(), 1);
+    if (hyperedge_base >= 0)
+        for (int i = 0; i < ids.size(); ++i)
+            mask[i] = ids[i] < hyperedge_base;
+
+    if (use_cache && !write_graph_cache(cache_path, path, hyperedge_base, hyperedges, ids, graph, mask))
+        fprintf(stderr, "WARNING: Could not write graph cache %s\n", cache_path.c_str());
+    return hyperedges;
+}
+
+#endif // GRAPH_CACHE_H
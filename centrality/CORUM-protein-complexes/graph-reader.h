@@ -0,0 +1,200 @@
+#ifndef GRAPH_READER_H
+#define GRAPH_READER_H
+
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <utility>
+#include "id-map.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/*
+ * Zero-copy input for the .graph and .hypergraph formats.
+ *
+ * The file is memory-mapped and integers are parsed in place by a hand-written
+ * scanner, so no std::string, stringstream or per-line buffer is ever built.
+ * All centrality programs load their datasets through these functions.
+ */
+
+// --- Read-only memory mapping of a whole file (mmap / Win32 file mapping) ---
+class MappedFile {
+public:
+    MappedFile() = default;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    ~MappedFile() { close(); }
+
+    bool open(const std::string& path) {
+        close();
+#ifdef _WIN32
+        file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+                           FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+        if (file == INVALID_HANDLE_VALUE) return false;
+        LARGE_INTEGER file_size;
+        GetFileSizeEx(file, &file_size);
+        length = (size_t)file_size.QuadPart;
+        if (length == 0) return true;
+        mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+        if (mapping == NULL) { close(); return false; }
+        bytes = (const char*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        if (bytes == NULL) { close(); return false; }
+#else
+        fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+        struct stat st;
+        if (fstat(fd, &st) != 0) { close(); return false; }
+        length = (size_t)st.st_size;
+        if (length == 0) return true;
+#ifdef MAP_POPULATE
+        // Pre-fault the whole mapping instead of taking one page fault per 4 KB
+        int flags = MAP_PRIVATE | MAP_POPULATE;
+#else
+        int flags = MAP_PRIVATE;
+#endif
+        void* p = mmap(NULL, length, PROT_READ, flags, fd, 0);
+        if (p == MAP_FAILED) { close(); return false; }
+        madvise(p, length, MADV_SEQUENTIAL);
+        bytes = (const char*)p;
+#endif
+        return true;
+    }
+
+    void close() {
+#ifdef _WIN32
+        if (bytes) UnmapViewOfFile(bytes);
+        if (mapping) CloseHandle(mapping);
+        if (file != INVALID_HANDLE_VALUE) CloseHandle(file);
+        mapping = NULL;
+        file = INVALID_HANDLE_VALUE;
+#else
+        if (bytes) munmap((void*)bytes, length);
+        if (fd >= 0) ::close(fd);
+        fd = -1;
+#endif
+        bytes = nullptr;
+        length = 0;
+    }
+
+    const char* data() const { return bytes; }
+    size_t size() const { return length; }
+
+private:
+    const char* bytes = nullptr;
+    size_t length = 0;
+#ifdef _WIN32
+    HANDLE file = INVALID_HANDLE_VALUE;
+    HANDLE mapping = NULL;
+#else
+    int fd = -1;
+#endif
+};
+
+// --- In-place integer scanner over a mapped buffer ---
+class IntScanner {
+public:
+    IntScanner(const char* begin, const char* end) : p(begin), last(end) {}
+
+    // Skips blanks on the current line; true if the line (or input) has ended.
+    bool at_line_end() {
+        while (p < last && (*p == ' ' || *p == '\t' || *p == '\r')) ++p;
+        return p >= last || *p == '\n';
+    }
+
+    // Moves past the next newline.
+    void next_line() {
+        while (p < last && *p != '\n') ++p;
+        if (p < last) ++p;
+    }
+
+    bool at_end() const { return p >= last; }
+
+    // Parses the next integer on the current line. Fails at the end of the
+    // line or on a token that is not an integer, like `stream >> int` does.
+    bool next_int(int& out) {
+        if (at_line_end()) return false;
+        return parse(out);
+    }
+
+    // Like next_int, but lets the integer sit on a later line.
+    bool next_int_any_line(int& out) {
+        while (p < last && (unsigned char)*p <= ' ') ++p;
+        return p < last && parse(out);
+    }
+
+private:
+    const char* p;
+    const char* last;
+
+    bool parse(int& out) {
+        bool negative = (*p == '-');
+        if (negative || *p == '+') ++p;
+        const char* start = p;
+        unsigned long long value = 0;
+        for (unsigned digit; p < last && (digit = (unsigned char)*p - '0') <= 9; ++p)
+            value = value * 10 + digit;
+        if (p == start) return false;
+        out = (int)(negative ? -(long long)value : (long long)value);
+        return true;
+    }
+};
+
+// Reads a .graph file: a "nodes edges" header followed by one "u v" pair per
+// edge. Endpoints are interned through `ids` in file order and appended to
+// `edges` as dense index pairs.
+inline bool load_graph_file(const std::string& path, IdMap& ids, std::vector<std::pair<int, int>>& edges) {
+    MappedFile file;
+    if (!file.open(path)) {
+        fprintf(stderr, "ERROR: Could not open graph file: %s\n", path.c_str());
+        return false;
+    }
+    IntScanner in(file.data(), file.data() + file.size());
+    int nodes = 0, declared = 0;
+    if (!in.next_int_any_line(nodes) || !in.next_int_any_line(declared))
+        return true;
+    edges.reserve(edges.size() + (declared > 0 ? declared : 0));
+
+    int u, v;
+    while (in.next_int_any_line(u) && in.next_int_any_line(v)) {
+        u = ids.intern(u);
+        v = ids.intern(v);
+        edges.push_back({u, v});
+    }
+    return true;
+}
+
+// Reads a .hypergraph file, one hyperedge per line, into the bipartite model:
+// line k becomes node `hyperedge_base + k` (interned before its members) and
+// gets an edge to every member protein. Blank lines are skipped. Returns the
+// number of hyperedges, or -1 if the file cannot be opened.
+inline int load_hypergraph_file(const std::string& path, int hyperedge_base, IdMap& ids,
+                                std::vector<std::pair<int, int>>& edges) {
+    MappedFile file;
+    if (!file.open(path)) {
+        fprintf(stderr, "ERROR: Could not open hypergraph file: %s\n", path.c_str());
+        return -1;
+    }
+    IntScanner in(file.data(), file.data() + file.size());
+    int hyperedges = 0;
+    while (!in.at_end()) {
+        int u;
+        if (in.next_int(u)) {
+            int v = ids.intern(hyperedge_base + hyperedges);
+            do {
+                edges.push_back({ids.intern(u), v});
+            } while (in.next_int(u));
+            ++hyperedges;
+        }
+        in.next_line();
+    }
+    return hyperedges;
+}
+
+#endif // GRAPH_READER_H
@@ -0,0 +1,330 @@
+#ifndef GRAPH_UPDATES_H
+#define GRAPH_UPDATES_H
+
+#include <cstdio>
+#include <cstdint>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <unordered_map>
+#include "csr-graph.h"
+#include "id-map.h"
+
+/*
+ * Incremental updates of the datasets: batches of hyperedge insertions and
+ * deletions, their effect on the bipartite model and on the clique expansion,
+ * and the per-source distance table that tells which traversals they change.
+ *
+ * An update file holds one change per line:
+ *
+ *   + id id ...   insert a hyperedge with these member proteins
+ *   - k           delete hyperedge k (0-based, counting non-blank lines of the
+ *                 .hypergraph file; inserted hyperedges are numbered after them)
+ *
+ * Blank lines and lines starting with '#' are skipped.
+ */
+struct HyperedgeBatch {
+    std::vector<std::vector<int>> inserted;
+    std::vector<int> deleted;
+    bool empty() const { return inserted.empty() && deleted.empty(); }
+};
+
+inline bool read_hyperedge_batch(const std::string& path, HyperedgeBatch& batch) {
+    std::ifstream in(path);
+    if (!in.is_open()) {
+        fprintf(stderr, "ERROR: Could not open update file: %s\n", path.c_str());
+        return false;
+    }
+    std::string line;
+    while (std::getline(in, line)) {
+        std::stringstream fields(line);
+        std::string op;
+        if (!(fields >> op) || op[0] == '#') continue;
+        int x;
+        if (op == "+") {
+            batch.inserted.emplace_back();
+            while (fields >> x) batch.inserted.back().push_back(x);
+        } else if (op == "-") {
+            while (fields >> x) batch.deleted.push_back(x);
+        } else {
+            fprintf(stderr, "WARNING: Skipping malformed update line: %s\n", line.c_str());
+        }
+    }
+    return true;
+}
+
+// One batch of changes to an undirected graph, in dense indices. In the
+// bipartite model the hyperedges behind `added` / `removed` are also kept, as
+// (hyperedge node, members), so affected sources can be found exactly.
+struct GraphChanges {
+    int num_nodes = 0;      // node count once the batch is applied
+    std::vector<std::pair<int, int>> added, removed;
+    std::vector<std::pair<int, std::vector<int>>> inserted, deleted;
+    bool empty() const { return added.empty() && removed.empty(); }
+};
+
+// Translates a batch for the bipartite model loaded with `hyperedge_base`:
+// deleted hyperedges lose all their edges, inserted ones become new nodes
+// numbered from `num_hyperedges` on (which is advanced). New nodes are interned
+// into `ids`.
+inline void bipartite_changes(const CSRGraph& g, IdMap& ids, int hyperedge_base, int& num_hyperedges,
+                              const HyperedgeBatch& batch, GraphChanges& out) {
+    std::vector<char> gone(g.size(), 0);
+    for (int k : batch.deleted) {
+        int e = ids.find(hyperedge_base + k);
+        if (e == IdMap::NONE || e >= g.size() || gone[e] || g.degree(e) == 0) continue;
+        gone[e] = 1;
+        std::vector<int> members(g.neighbors(e).begin(), g.neighbors(e).end());
+        for (int w : members) out.removed.push_back({e, w});
+        out.deleted.push_back({e, members});
+    }
+    for (const auto& list : batch.inserted) {
+        int e = ids.intern(hyperedge_base + num_hyperedges++);
+        std::vector<int> members;
+        for (int id : list) members.push_back(ids.intern(id));
+        std::sort(members.begin(), members.end());
+        members.erase(std::unique(members.begin(), members.end()), members.end());
+        for (int w : members) out.added.push_back({w, e});
+        out.inserted.push_back({e, members});
+    }
+    out.num_nodes = ids.size();
+}
+
+// Translates a batch for the clique expansion (`ids` maps the .graph nodes),
+// given the bipartite model of the hypergraph it was generated from. A pair
+// of a deleted hyperedge only loses its edge if no other remaining or inserted
+// hyperedge still holds both proteins.
+inline void clique_changes(const CSRGraph& bipartite, const IdMap& bipartite_ids, int hyperedge_base,
+                           const HyperedgeBatch& batch, IdMap& ids, GraphChanges& out) {
+    int total = bipartite.size();
+    std::vector<char> gone(total, 0);
+    for (int k : batch.deleted) {
+        int e = bipartite_ids.find(hyperedge_base + k);
+        if (e != IdMap::NONE && e < total) gone[e] = 1;
+    }
+    // Inserted hyperedges of every protein ID, numbered after the existing ones
+    std::unordered_map<int, std::vector<int>> inserted_of;
+    for (size_t h = 0; h < batch.inserted.size(); ++h)
+        for (int id : batch.inserted[h]) inserted_of[id].push_back(total + (int)h);
+
+    std::vector<int> mark(total + batch.inserted.size(), -1);
+    for (int e = 0; e < total; ++e) {
+        if (!gone[e]) continue;
+        const auto members = bipartite.neighbors(e);
+        for (int a : members) {
+            // Hyperedges that keep holding `a`
+            for (int h : bipartite.neighbors(a))
+                if (!gone[h]) mark[h] = a;
+            auto extra = inserted_of.find(bipartite_ids[a]);
+            if (extra != inserted_of.end())
+                for (int h : extra->second) mark[h] = a;
+            for (int b : members) {
+                if (b <= a) continue;
+                bool covered = false;
+                for (int h : bipartite.neighbors(b))
+                    covered = covered || mark[h] == a;
+                auto more = inserted_of.find(bipartite_ids[b]);
+                if (more != inserted_of.end())
+                    for (int h : more->second) covered = covered || mark[h] == a;
+                int u = ids.find(bipartite_ids[a]), v = ids.find(bipartite_ids[b]);
+                if (!covered && u != IdMap::NONE && v != IdMap::NONE)
+                    out.removed.push_back({u, v});
+            }
+        }
+    }
+    for (const auto& list : batch.inserted) {
+        std::vector<int> members = list;
+        std::sort(members.begin(), members.end());
+        members.erase(std::unique(members.begin(), members.end()), members.end());
+        for (size_t x = 0; x < members.size(); ++x)
+            for (size_t y = x + 1; y < members.size(); ++y)
+                out.added.push_back({ids.intern(members[x]), ids.intern(members[y])});
+    }
+    out.num_nodes = ids.size();
+}
+
+// Applies `changes` to an undirected graph. Rows of the touched nodes come out
+// sorted and deduplicated, all other rows keep their order; the arrays are
+// re-laid in one counting-sort pass. Returns the touched nodes.
+inline std::vector<int> apply_changes(CSRGraph& g, const GraphChanges& changes) {
+    int n = std::max(changes.num_nodes, g.size());
+    std::vector<int> slot(n, -1), touched;
+    std::vector<std::vector<int>> rows;
+    auto row = [&](int v) -> std::vector<int>& {
+        if (slot[v] < 0) {
+            slot[v] = (int)touched.size();
+            touched.push_back(v);
+            rows.emplace_back();
+            if (v < g.size()) rows.back().assign(g.neighbors(v).begin(), g.neighbors(v).end());
+        }
+        return rows[slot[v]];
+    };
+    for (const auto& [u, v] : changes.added) {
+        if (u == v) continue;
+        row(u).push_back(v);
+        row(v).push_back(u);
+    }
+    for (const auto& [u, v] : changes.removed) {
+        row(u);
+        row(v);
+    }
+    for (auto& r : rows) {
+        std::sort(r.begin(), r.end());
+        r.erase(std::unique(r.begin(), r.end()), r.end());
+    }
+    auto drop = [](std::vector<int>& r, int x) {
+        auto it = std::lower_bound(r.begin(), r.end(), x);
+        if (it != r.end() && *it == x) r.erase(it);
+    };
+    for (const auto& [u, v] : changes.removed) {
+        drop(rows[slot[u]], v);
+        drop(rows[slot[v]], u);
+    }
+
+    std::vector<std::pair<int, int>> arcs;
+    arcs.reserve(g.num_arcs() + 2 * changes.added.size());
+    for (int v = 0; v < n; ++v) {
+        if (slot[v] >= 0) {
+            for (int w : rows[slot[v]]) arcs.push_back({v, w});
+        } else if (v < g.size()) {
+            for (int w : g.neighbors(v)) arcs.push_back({v, w});
+        }
+    }
+    g.build(n, arcs, false);
+    return touched;
+}
+
+/*
+ * BFS levels of every source, kept so an update only reruns the sources whose
+ * shortest-path DAG (distances and path counts) it changes:
+ *   - an inserted edge (u, v) changes it iff d(u) != d(v);
+ *   - a removed edge changes it iff |d(u) - d(v)| = 1;
+ *   - an inserted hyperedge changes it iff its reached members are 2 or more
+ *     levels apart, or some are reached and others not;
+ *   - a deleted hyperedge e changes it iff a member sits at d(e) + 1.
+ * When only distances matter (closeness), insertions must bring two nodes one
+ * level closer than before to count: |d(u) - d(v)| >= 2 for an edge, members
+ * 3 or more levels apart for a hyperedge. Levels are stored as 16-bit values;
+ * a deeper traversal makes every source count as affected.
+ *
+ * Those tests only read the nodes the batch touches, so after watch() (with
+ * batch_nodes()) a row holds just their levels: sources x watched nodes
+ * instead of a full V x V table. A batch that links a reached node to an
+ * unreached or new one changes every traversal that reaches it, so such a
+ * batch still reruns the whole component.
+ */
+class SourceDistances {
+public:
+    static constexpr uint16_t UNREACHED = 0xFFFF;
+
+    // Makes room for sources [0, n); rows of distinct sources can then be
+    // filled from several threads at once.
+    void resize(int n) {
+        if (n > (int)rows.size()) rows.resize(n);
+    }
+
+    // Keeps only the levels of `nodes`; every other node reads as unreached,
+    // so they must include every node affected() is asked about.
+    void watch(const std::vector<int>& nodes) {
+        watching = true;
+        column.clear();
+        width = 0;
+        for (int v : nodes) {
+            if (v >= (int)column.size()) column.resize(v + 1, -1);
+            if (column[v] < 0) column[v] = width++;
+        }
+    }
+
+    // Starts the row of `source` for a graph of n nodes, all unreached.
+    void begin(int source, int n) { rows[source].assign(watching ? width : n, UNREACHED); }
+
+    void set(int source, int v, int level) {
+        int c = slot(v);
+        if (c < 0) return;
+        if (level >= UNREACHED) {
+            saturated = true;
+            level = UNREACHED - 1;
+        }
+        rows[source][c] = (uint16_t)level;
+    }
+
+    bool affected(int source, const GraphChanges& changes, bool distances_only = false) const {
+        if (saturated || source >= (int)rows.size() || rows[source].empty()) return true;
+        const std::vector<uint16_t>& d = rows[source];
+        auto dist = [&](int v) {
+            int c = slot(v);
+            return c >= 0 && c < (int)d.size() ? d[c] : UNREACHED;
+        };
+        int slack = distances_only ? 1 : 0;
+        if (!changes.inserted.empty() || !changes.deleted.empty()) {
+            for (const auto& [e, members] : changes.deleted) {
+                if (dist(e) == UNREACHED) continue;
+                for (int m : members)
+                    if (dist(m) == dist(e) + 1) return true;
+            }
+            for (const auto& [e, members] : changes.inserted) {
+                int lo = UNREACHED, hi = 0;
+                bool unreached = false;
+                for (int m : members) {
+                    int dm = dist(m);
+                    if (dm == UNREACHED) {
+                        unreached = true;
+                    } else {
+                        lo = std::min(lo, dm);
+                        hi = std::max(hi, dm);
+                    }
+                }
+                if (lo != UNREACHED && (unreached || hi - lo >= 2 + slack)) return true;
+            }
+            return false;
+        }
+        for (const auto& [u, v] : changes.removed)
+            if (dist(u) != UNREACHED && dist(v) != UNREACHED && std::abs(dist(u) - dist(v)) == 1) return true;
+        for (const auto& [u, v] : changes.added) {
+            if (dist(u) == dist(v)) continue;
+            if (dist(u) == UNREACHED || dist(v) == UNREACHED || std::abs(dist(u) - dist(v)) >= 1 + slack) return true;
+        }
+        return false;
+    }
+
+private:
+    std::vector<std::vector<uint16_t>> rows;
+    bool saturated = false;
+    // watch(): the row slot of every node (-1 if not watched)
+    bool watching = false;
+    std::vector<int> column;
+    int width = 0;
+
+    int slot(int v) const {
+        if (!watching) return v;
+        return v < (int)column.size() ? column[v] : -1;
+    }
+};
+
+// Nodes of `ids` whose levels SourceDistances::affected() reads for `batch`:
+// the members of the deleted and inserted hyperedges, and the deleted
+// hyperedge nodes themselves when `ids` numbers the bipartite graph. The
+// members of a deleted hyperedge are read from `bipartite`.
+inline std::vector<int> batch_nodes(const CSRGraph& bipartite, const IdMap& bipartite_ids, int hyperedge_base,
+                                    const HyperedgeBatch& batch, const IdMap& ids) {
+    std::vector<int> nodes;
+    auto add = [&](int id) {
+        int v = ids.find(id);
+        if (v != IdMap::NONE) nodes.push_back(v);
+    };
+    for (int k : batch.deleted) {
+        int e = bipartite_ids.find(hyperedge_base + k);
+        if (e == IdMap::NONE || e >= bipartite.size()) continue;
+        add(hyperedge_base + k);
+        for (int m : bipartite.neighbors(e)) add(bipartite_ids[m]);
+    }
+    for (const auto& members : batch.inserted)
+        for (int id : members) add(id);
+    return nodes;
+}
+
+#endif // GRAPH_UPDATES_H
@@ -0,0 +1,158 @@
+#ifndef HYPERGRAPH_BFS_H
+#define HYPERGRAPH_BFS_H
+
+#include <vector>
+#include "csr-graph.h"
+#include "visit-marks.h"
+
+/*
+ * Breadth-first traversals of a hypergraph in hypergraph hops.
+ *
+ * The hypergraph is the bipartite graph load_dataset() builds: a protein's
+ * neighbors are its hyperedges and a hyperedge's neighbors are its members,
+ * so the two incidence directions are the two halves of one CSR. Starting
+ * from a protein, each level opens the hyperedges of the current proteins,
+ * once per source, and their members not yet reached form the next level.
+ *
+ * Only proteins go into `order` and get a distance. A hyperedge opened from
+ * level d gets level[e] = d, which the path counts need. Its bipartite
+ * distance from the source is 2 * d + 1. The order of opened hyperedges is
+ * kept in `edges`. The protein and hyperedge indices are disjoint, so one
+ * `visited` and one `level` array cover both.
+ *
+ * paths() also records the shortest-path DAG as two flat lists, reused from
+ * source to source: the hyperedges each protein opens toward the next level,
+ * and the members each hyperedge reaches there. dependencies() then pulls
+ * Brandes' dependencies along those lists only.
+ *
+ * With `weight` (a reduced hypergraph, see hypergraph-reduction.h) every
+ * node but the source stands for weight[x] interchangeable copies: paths
+ * pass through each copy, each copy is a target, and sigma and delta are per
+ * copy.
+ */
+class HypergraphBFS {
+public:
+    // Hop distances from `source`: reached proteins go to `order` level by
+    // level (the source first) and opened hyperedges to `edges`.
+    void levels(const CSRGraph& g, int source, VisitMarks& visited, std::vector<int>& order, std::vector<int>& edges,
+                std::vector<int>& level) {
+        start(source, visited, order, edges, level);
+        for (size_t head = 0; head < order.size(); ++head) {
+            int p = order[head];
+            for (int e : g.neighbors(p)) {
+                if (!visited.mark(e)) continue;
+                level[e] = level[p];
+                edges.push_back(e);
+                for (int q : g.neighbors(e))
+                    if (visited.mark(q)) {
+                        level[q] = level[p] + 1;
+                        order.push_back(q);
+                    }
+            }
+        }
+    }
+
+    // levels() plus the number of shortest bipartite paths from `source` to
+    // every reached protein and opened hyperedge (`sigma`). Every protein of
+    // a level adds to its hyperedges before any of them is expanded, so each
+    // level takes two passes.
+    void paths(const CSRGraph& g, int source, VisitMarks& visited, std::vector<int>& order, std::vector<int>& edges,
+               std::vector<int>& level, std::vector<double>& sigma, const std::vector<double>* weight = nullptr) {
+        start(source, visited, order, edges, level);
+        sigma[source] = 1;
+        protein_children.clear();
+        protein_end.clear();
+        edge_children.clear();
+        edge_end.clear();
+        for (size_t lo = 0, hi; lo < order.size(); lo = hi) {
+            hi = order.size();
+            int d = level[order[lo]];
+            size_t first = edges.size();
+            for (size_t i = lo; i < hi; ++i) {
+                int p = order[i];
+                double through = sigma[p] * (weight && p != source ? (*weight)[p] : 1);
+                for (int e : g.neighbors(p)) {
+                    if (visited.mark(e)) {
+                        level[e] = d;
+                        sigma[e] = 0;
+                        edges.push_back(e);
+                    }
+                    if (level[e] == d) {
+                        sigma[e] += through;
+                        protein_children.push_back(e);
+                    }
+                }
+                protein_end.push_back(protein_children.size());
+            }
+            for (size_t j = first; j < edges.size(); ++j) {
+                int e = edges[j];
+                double through = sigma[e] * (weight ? (*weight)[e] : 1);
+                for (int q : g.neighbors(e)) {
+                    if (visited.mark(q)) {
+                        level[q] = d + 1;
+                        sigma[q] = 0;
+                        order.push_back(q);
+                    }
+                    if (level[q] == d + 1) {
+                        sigma[q] += through;
+                        edge_children.push_back(q);
+                    }
+                }
+                edge_end.push_back(edge_children.size());
+            }
+        }
+    }
+
+    // Brandes' dependency pass over the last paths(), from the farthest level
+    // back. Proteins are the only targets that count, so a hyperedge passes
+    // on its dependency without adding itself. credit(q, delta[q]) runs for
+    // every reached protein but the source.
+    template <class Credit>
+    void dependencies(int source, const std::vector<int>& order, const std::vector<int>& edges,
+                      const std::vector<int>& level, const std::vector<double>& sigma, std::vector<double>& delta,
+                      Credit&& credit, const std::vector<double>* weight = nullptr) const {
+        size_t j = edges.size();
+        for (size_t k = order.size(); k-- > 0; ) {
+            int q = order[k];
+            int d = level[q];
+            // Hyperedges opened from level d only lead to level d + 1, which
+            // is done before the first protein of level d comes up
+            for (; j > 0 && level[edges[j - 1]] == d; --j) {
+                int e = edges[j - 1];
+                double sum = 0;
+                for (size_t c = j > 1 ? edge_end[j - 2] : 0; c < edge_end[j - 1]; ++c) {
+                    int child = edge_children[c];
+                    double copies = weight ? (*weight)[child] : 1;
+                    sum += copies * (sigma[e] / sigma[child]) * (1 + delta[child]);
+                }
+                delta[e] = sum;
+            }
+            double sum = 0;
+            for (size_t c = k > 0 ? protein_end[k - 1] : 0; c < protein_end[k]; ++c) {
+                int e = protein_children[c];
+                double copies = weight ? (*weight)[e] : 1;
+                sum += copies * (sigma[q] / sigma[e]) * delta[e];
+            }
+            delta[q] = sum;
+            if (q != source) credit(q, sum);
+        }
+    }
+
+private:
+    std::vector<int> protein_children;      // per protein of `order`, ending at protein_end[i]
+    std::vector<size_t> protein_end;
+    std::vector<int> edge_children;         // per hyperedge of `edges`, ending at edge_end[j]
+    std::vector<size_t> edge_end;
+
+    static void start(int source, VisitMarks& visited, std::vector<int>& order, std::vector<int>& edges,
+                      std::vector<int>& level) {
+        visited.clear();
+        order.clear();
+        edges.clear();
+        visited.mark(source);
+        level[source] = 0;
+        order.push_back(source);
+    }
+};
+
+#endif // HYPERGRAPH_BFS_H
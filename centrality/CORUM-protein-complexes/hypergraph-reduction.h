@@ -0,0 +1,147 @@
+#ifndef HYPERGRAPH_REDUCTION_H
+#define HYPERGRAPH_REDUCTION_H
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+#include "csr-graph.h"
+
+/*
+ * Structural reduction of a hypergraph for the traversal-based measures.
+ *
+ * Complexes listed more than once (the same member set) collapse into one
+ * hyperedge whose weight is its multiplicity. Proteins that belong to
+ * exactly the same complexes are structural twins: every other protein is
+ * equally far from each of them, and they lie on the same shortest paths.
+ * They collapse into one protein class whose weight is its size. Twins are
+ * one hop apart and never lie on each other's shortest paths.
+ *
+ * The reduced graph is bipartite again, so it runs through HypergraphBFS
+ * (hypergraph-bfs.h). One traversal per protein class replaces one per
+ * protein:
+ *   - Distances: a reached class counts once per member. The other members
+ *     of the source's own class are one hop away (see distance_sums()).
+ *   - Shortest paths: every reached node but the source is passed through
+ *     once per copy (HypergraphBFS::paths() with the weights). The
+ *     dependency of a class is per member, and a traversal from a class
+ *     stands for one traversal from each of its members.
+ * Proteins without complexes are never merged.
+ */
+class HypergraphReduction {
+public:
+    // Reduces the bipartite graph `g` built by load_dataset(); `protein`
+    // flags its protein nodes.
+    void build(const CSRGraph& g, const std::vector<char>& protein) {
+        int n = g.size();
+        std::vector<std::vector<int>> key(n);
+        auto sorted_neighbors = [&](int v) {
+            std::vector<int> list(g.neighbors(v).begin(), g.neighbors(v).end());
+            std::sort(list.begin(), list.end());
+            list.erase(std::unique(list.begin(), list.end()), list.end());
+            return list;
+        };
+
+        // Hyperedges with equal member sets, then proteins with equal sets of
+        // collapsed hyperedges, share a class
+        class_of.assign(n, -1);
+        std::vector<int> edge_class(n, -1);
+        for (int v = 0; v < n; ++v)
+            if (!protein[v]) key[v] = sorted_neighbors(v);
+        group(n, key, [&](int v) { return !protein[v]; }, edge_class);
+        for (int v = 0; v < n; ++v) {
+            if (!protein[v]) continue;
+            key[v].clear();
+            for (int e : g.neighbors(v)) key[v].push_back(edge_class[e]);
+            std::sort(key[v].begin(), key[v].end());
+            key[v].erase(std::unique(key[v].begin(), key[v].end()), key[v].end());
+            // A protein without complexes keeps a class of its own
+            if (key[v].empty()) key[v].push_back(-1 - v);
+        }
+        std::vector<int> protein_class(n, -1);
+        group(n, key, [&](int v) { return (bool)protein[v]; }, protein_class);
+        key = std::vector<std::vector<int>>();
+
+        // Reduced nodes are numbered in the order their first member appears
+        std::vector<int> index(n, -1);
+        weights.clear();
+        is_protein.clear();
+        protein_classes = edge_classes = 0;
+        for (int v = 0; v < n; ++v) {
+            int c = protein[v] ? protein_class[v] : edge_class[v];
+            int& x = index[c];
+            if (x < 0) {
+                x = weights.size();
+                weights.push_back(0);
+                is_protein.push_back(protein[v]);
+                ++(protein[v] ? protein_classes : edge_classes);
+            }
+            class_of[v] = x;
+            ++weights[x];
+        }
+
+        // One edge per (collapsed hyperedge, member class)
+        std::vector<std::pair<int, int>> edges;
+        std::vector<int> seen(weights.size(), -1);
+        for (int v = 0; v < n; ++v) {
+            int x = class_of[v];
+            if (protein[v] || seen[x] >= 0) continue;
+            seen[x] = x;
+            for (int p : g.neighbors(v))
+                if (seen[class_of[p]] != x) {
+                    seen[class_of[p]] = x;
+                    edges.push_back({x, class_of[p]});
+                }
+        }
+        reduced.build(weights.size(), edges);
+        original_arcs = g.num_arcs();
+    }
+
+    const CSRGraph& graph() const { return reduced; }
+    int size() const { return reduced.size(); }
+    // Number of original proteins or hyperedges behind reduced node x
+    const std::vector<double>& weight() const { return weights; }
+    bool protein(int x) const { return is_protein[x]; }
+    int num_protein_classes() const { return protein_classes; }
+    int num_hyperedge_classes() const { return edge_classes; }
+    // Reduced node of original node v
+    int reduced_index(int v) const { return class_of[v]; }
+    long long arcs_removed() const { return original_arcs - reduced.num_arcs(); }
+
+    // Distance sums of protein class `source` from a HypergraphBFS::levels()
+    // run on graph(): `order` holds the reached protein classes (the source
+    // first) with their hop counts in `level`.
+    void distance_sums(int source, const std::vector<int>& order, const std::vector<int>& level, double& dist_sum,
+                       double& inv_sum, double& reached) const {
+        double twins = weights[source] - 1;
+        dist_sum = inv_sum = reached = twins;
+        for (int q : order) {
+            if (q == source) continue;
+            dist_sum += weights[q] * level[q];
+            inv_sum += weights[q] / level[q];
+            reached += weights[q];
+        }
+    }
+
+private:
+    CSRGraph reduced;
+    std::vector<double> weights;
+    std::vector<char> is_protein;
+    std::vector<int> class_of;
+    int protein_classes = 0;
+    int edge_classes = 0;
+    long long original_arcs = 0;
+
+    // Gives the nodes selected by `take` with equal keys one class ID (the
+    // index of their first member) in `cls`
+    template <class Take>
+    static void group(int n, const std::vector<std::vector<int>>& key, Take take, std::vector<int>& cls) {
+        std::vector<int> nodes;
+        for (int v = 0; v < n; ++v)
+            if (take(v)) nodes.push_back(v);
+        std::stable_sort(nodes.begin(), nodes.end(), [&](int a, int b) { return key[a] < key[b]; });
+        for (size_t i = 0; i < nodes.size(); ++i)
+            cls[nodes[i]] = (i > 0 && key[nodes[i]] == key[nodes[i - 1]]) ? cls[nodes[i - 1]] : nodes[i];
+    }
+};
+
+#endif // HYPERGRAPH_REDUCTION_H
@@ -0,0 +1,143 @@
+#ifndef ID_MAP_H
+#define ID_MAP_H
+
+#include <vector>
+#include <numeric>
+#include <algorithm>
+#include <cstdint>
+#include <climits>
+
+/*
+ * Interns original node IDs into dense indices 0 .. size()-1.
+ *
+ * prepare_corum_data.py numbers genes 0, 1, 2, ... in first-seen order, so
+ * small non-negative IDs are resolved through a direct-indexed table that grows
+ * with the number of interned nodes. IDs that would make that table sparse
+ * (such as the MAXN + k hyperedge nodes) go to an open-addressing hash table
+ * with linear probing. Both paths are O(1); the reverse mapping is a plain
+ * contiguous array. INT_MIN marks empty hash slots, so that one ID keeps its
+ * index in a member of its own.
+ */
+class IdMap {
+public:
+    static constexpr int NONE = -1;
+
+    // Index of `id`, or NONE if it was never interned.
+    int find(int id) const {
+        if (id >= 0 && id < (int)direct.size())
+            return direct[id];
+        if (id == EMPTY)
+            return empty_index;
+        if (keys.empty())
+            return NONE;
+        for (size_t slot = hash(id);; slot = (slot + 1) & (keys.size() - 1)) {
+            if (keys[slot] == id) return values[slot];
+            if (keys[slot] == EMPTY) return NONE;
+        }
+    }
+
+    // Index of `id`, assigning the next free index the first time it is seen.
+    int intern(int id) {
+        if (id >= 0 && id < (int)direct.size()) {
+            int& idx = direct[id];
+            if (idx == NONE) idx = append(id);
+            return idx;
+        }
+        if (id >= 0 && id < direct_limit()) {
+            grow_direct(std::min<size_t>(std::max<size_t>((size_t)id + 1, direct.size() * 2), direct_limit()));
+            if (direct[id] == NONE) direct[id] = append(id);
+            return direct[id];
+        }
+        if (id == EMPTY) {
+            if (empty_index == NONE) empty_index = append(id);
+            return empty_index;
+        }
+        if ((hashed + 1) * 2 > keys.size())
+            rehash(std::max<size_t>(16, keys.size() * 2));
+        size_t slot = hash(id);
+        while (keys[slot] != EMPTY && keys[slot] != id)
+            slot = (slot + 1) & (keys.size() - 1);
+        if (keys[slot] == id)
+            return values[slot];
+        keys[slot] = id;
+        ++hashed;
+        return values[slot] = append(id);
+    }
+
+    int size() const { return (int)idx_to_node.size(); }
+    int operator[](int idx) const { return idx_to_node[idx]; }
+    const std::vector<int>& nodes() const { return idx_to_node; }
+
+    // Indices ordered by original ID, i.e. the iteration order of the old
+    // std::map<int, int> node_to_idx that the output files are written in.
+    std::vector<int> sorted_indices() const {
+        std::vector<int> order(idx_to_node.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(), [&](int a, int b) { return idx_to_node[a] < idx_to_node[b]; });
+        return order;
+    }
+
+    void clear() {
+        direct.clear();
+        keys.clear();
+        values.clear();
+        idx_to_node.clear();
+        hashed = 0;
+        shift = 32;
+        empty_index = NONE;
+    }
+
+private:
+    static constexpr int EMPTY = INT_MIN;
+
+    std::vector<int> direct;
+    std::vector<int> keys;
+    std::vector<int> values;
+    std::vector<int> idx_to_node;
+    size_t hashed = 0;
+    int shift = 32;
+    // Index of the ID equal to EMPTY, which cannot live in `keys`
+    int empty_index = NONE;
+
+    // The direct table may hold at most about two slots per interned node
+    int direct_limit() const { return 2 * size() + 4096; }
+
+    // Fibonacci hashing: keep the top bits of the multiplicative hash
+    size_t hash(int id) const {
+        return (size_t)(((uint32_t)id * 2654435769u) >> shift);
+    }
+
+    int append(int id) {
+        idx_to_node.push_back(id);
+        return (int)idx_to_node.size() - 1;
+    }
+
+    // Extends the direct table, copying in hashed IDs that now fall inside it
+    // so both paths agree on their index.
+    void grow_direct(size_t new_size) {
+        int old_size = (int)direct.size();
+        direct.resize(new_size, NONE);
+        for (size_t i = 0; i < keys.size(); ++i)
+            if (keys[i] != EMPTY && keys[i] >= old_size && keys[i] < (int)new_size)
+                direct[keys[i]] = values[i];
+    }
+
+    void rehash(size_t capacity) {
+        std::vector<int> old_keys(capacity, EMPTY), old_values(capacity);
+        old_keys.swap(keys);
+        old_values.swap(values);
+        shift = 32;
+        for (size_t c = capacity; c > 1; c >>= 1)
+            --shift;
+        for (size_t i = 0; i < old_keys.size(); ++i) {
+            if (old_keys[i] == EMPTY) continue;
+            size_t slot = hash(old_keys[i]);
+            while (keys[slot] != EMPTY)
+                slot = (slot + 1) & (keys.size() - 1);
+            keys[slot] = old_keys[i];
+            values[slot] = old_values[i];
+        }
+    }
+};
+
+#endif // ID_MAP_H
@@ -0,0 +1,215 @@
+#ifndef MEMORY_TRACKER_H
+#define MEMORY_TRACKER_H
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+#include <string>
+#include <vector>
+#if defined(__APPLE__)
+#include <malloc/malloc.h>
+#else
+#include <malloc.h>
+#endif
+
+/*
+ * Measured memory for the "Memory Used" figure of every output header.
+ *
+ * The global operator new / delete are replaced by versions that count the
+ * bytes malloc actually hands out (malloc_usable_size, plus the one-word chunk
+ * header glibc keeps in front of every block), so vector slack and allocator
+ * rounding are included. Memory that never goes through operator new, such as
+ * static arrays and memory-mapped snapshots, shows up in the peak resident set
+ * size read from VmHWM in /proc/self/status.
+ *
+ * On Windows (MSYS2 UCRT64) the block sizes come from _msize / _aligned_msize
+ * and over-aligned blocks from _aligned_malloc, since the UCRT has neither
+ * malloc_usable_size nor an aligned_alloc that free() accepts. There is no
+ * /proc there (nor on other non-Linux systems), so the peak RSS reads as 0.
+ * macOS has no malloc_usable_size either; its malloc_size from
+ * <malloc/malloc.h> reports the same usable size of a block.
+ *
+ * The replacement functions are defined here, so every program includes this
+ * header from its one translation unit only.
+ */
+namespace memtrack {
+    // Bytes currently allocated, the high-water mark since the last
+    // reset_peak(), and the number of allocations so far
+    inline std::atomic<long long> live{0};
+    inline std::atomic<long long> peak{0};
+    inline std::atomic<unsigned long long> allocations{0};
+
+    // Only alignments above malloc's own need a separate allocation path
+    inline size_t extended(size_t align) { return align > alignof(std::max_align_t) ? align : 0; }
+
+    inline size_t block_size(void* p, size_t align) {
+#ifdef _WIN32
+        return (align ? _aligned_msize(p, align, 0) : _msize(p)) + sizeof(void*);
+#elif defined(__APPLE__)
+        (void)align;
+        return malloc_size(p) + sizeof(void*);
+#else
+        (void)align;
+        return malloc_usable_size(p) + sizeof(void*);
+#endif
+    }
+
+    inline void on_alloc(void* p, size_t align) {
+        long long bytes = (long long)block_size(p, align);
+        long long now = live.fetch_add(bytes, std::memory_order_relaxed) + bytes;
+        long long seen = peak.load(std::memory_order_relaxed);
+        while (now > seen && !peak.compare_exchange_weak(seen, now, std::memory_order_relaxed)) {}
+        allocations.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    inline void on_free(void* p, size_t align) {
+        live.fetch_sub((long long)block_size(p, align), std::memory_order_relaxed);
+    }
+
+    inline void* allocate(size_t n, size_t align, bool nothrow) {
+        if (n == 0) n = 1;
+        align = extended(align);
+#ifdef _WIN32
+        void* p = align ? _aligned_malloc(n, align) : malloc(n);
+#else
+        void* p = align ? aligned_alloc(align, (n + align - 1) / align * align) : malloc(n);
+#endif
+        if (!p) {
+            if (nothrow) return nullptr;
+            throw std::bad_alloc();
+        }
+        on_alloc(p, align);
+        return p;
+    }
+
+    inline void release(void* p, size_t align = 0) {
+        if (!p) return;
+        align = extended(align);
+        on_free(p, align);
+#ifdef _WIN32
+        if (align) {
+            _aligned_free(p);
+            return;
+        }
+#endif
+        free(p);
+    }
+
+    inline void reset_peak() { peak.store(live.load(std::memory_order_relaxed), std::memory_order_relaxed); }
+
+    // Peak resident set size in bytes (VmHWM), or 0 where /proc is unavailable
+    inline unsigned long long peak_rss() {
+#ifdef __linux__
+        FILE* f = fopen("/proc/self/status", "r");
+        if (!f) return 0;
+        char line[256];
+        unsigned long long kb = 0;
+        while (fgets(line, sizeof(line), f))
+            if (strncmp(line, "VmHWM:", 6) == 0) {
+                kb = strtoull(line + 6, nullptr, 10);
+                break;
+            }
+        fclose(f);
+        return kb * 1024;
+#else
+        return 0;
+#endif
+    }
+
+    // Lowers VmHWM to the current resident set size (Linux 4.0+). Returns
+    // false if the kernel refused, in which case VmHWM keeps the peak of the
+    // whole process.
+    inline bool reset_peak_rss() {
+#ifdef __linux__
+        FILE* f = fopen("/proc/self/clear_refs", "w");
+        if (!f) return false;
+        bool ok = fputs("5", f) >= 0;
+        return fclose(f) == 0 && ok;
+#else
+        return false;
+#endif
+    }
+} // namespace memtrack
+
+void* operator new(size_t n) { return memtrack::allocate(n, 0, false); }
+void* operator new[](size_t n) { return memtrack::allocate(n, 0, false); }
+void* operator new(size_t n, const std::nothrow_t&) noexcept { return memtrack::allocate(n, 0, true); }
+void* operator new[](size_t n, const std::nothrow_t&) noexcept { return memtrack::allocate(n, 0, true); }
+void* operator new(size_t n, std::align_val_t a) { return memtrack::allocate(n, (size_t)a, false); }
+void* operator new[](size_t n, std::align_val_t a) { return memtrack::allocate(n, (size_t)a, false); }
+void operator delete(void* p) noexcept { memtrack::release(p); }
+void operator delete[](void* p) noexcept { memtrack::release(p); }
+void operator delete(void* p, size_t) noexcept { memtrack::release(p); }
+void operator delete[](void* p, size_t) noexcept { memtrack::release(p); }
+void operator delete(void* p, std::align_val_t a) noexcept { memtrack::release(p, (size_t)a); }
+void operator delete[](void* p, std::align_val_t a) noexcept { memtrack::release(p, (size_t)a); }
+void operator delete(void* p, size_t, std::align_val_t a) noexcept { memtrack::release(p, (size_t)a); }
+void operator delete[](void* p, size_t, std::align_val_t a) noexcept { memtrack::release(p, (size_t)a); }
+
+/*
+ * Heap and resident-set peaks of the phases of one run (load, build, compute,
+ * output). begin() closes the running phase and opens the next; each phase
+ * records the highest number of live heap bytes and the VmHWM reached while
+ * it was running. heap_peak() and rss_peak() are the maxima over the phases
+ * closed so far, which is what the output headers report.
+ */
+class MemoryPhases {
+public:
+    struct Phase {
+        std::string name;
+        unsigned long long heap = 0;
+        unsigned long long rss = 0;
+    };
+
+    void begin(const std::string& name) {
+        end();
+        memtrack::reset_peak();
+        memtrack::reset_peak_rss();
+        phases.push_back({name});
+        open = true;
+    }
+
+    void end() {
+        if (!open) return;
+        phases.back().heap = memtrack::peak.load(std::memory_order_relaxed);
+        phases.back().rss = memtrack::peak_rss();
+        open = false;
+    }
+
+    unsigned long long heap_peak() const {
+        unsigned long long most = 0;
+        for (const auto& p : phases) most = std::max(most, p.heap);
+        return most;
+    }
+
+    unsigned long long rss_peak() const {
+        unsigned long long most = 0;
+        for (const auto& p : phases) most = std::max(most, p.rss);
+        return most;
+    }
+
+    const std::vector<Phase>& list() const { return phases; }
+
+    // One line per closed phase: "<name>: heap <bytes> Bytes, peak RSS <bytes> Bytes"
+    std::string report() const {
+        std::string out;
+        char line[128];
+        for (const auto& p : phases) {
+            if (&p == &phases.back() && open) break;
+            snprintf(line, sizeof(line), "  %-10s heap %llu Bytes, peak RSS %llu Bytes\n", (p.name + ":").c_str(),
+                     p.heap, p.rss);
+            out += line;
+        }
+        return out;
+    }
+
+private:
+    std::vector<Phase> phases;
+    bool open = false;
+};
+
+#endif // MEMORY_TRACKER_H
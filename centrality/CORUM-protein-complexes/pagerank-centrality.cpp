@@ -1,16 +1,23 @@
 #include <iostream>
 #include <fstream>
-#include <sstream>
 #include <string>
 #include <vector>
-#include <map>
 #include <cmath>
 #include <chrono>
 #include <iomanip>
 #include <algorithm>
-#include <numeric>
 #include <ctype.h>
-#include <limits>
+#include <sstream>
+#include "id-map.h"
+#include "graph-cache.h"
+#include "clique-view.h"
+#include "cli-options.h"
+#include "seed-sets.h"
+#include "graph-updates.h"
+#include "pagerank.h"
+#include "profiler.h"
+#include "result-writer.h"
+#include "vertex-order.h"
 
 using namespace std;
 
@@ -22,191 +29,202 @@ vector<string> dataset;
 vector<string> graphs;
 vector<string> hypergraphs;
 vector<string> names;
-
-// --- Provided PageRank Implementation (wrapped in a namespace) ---
-namespace pageRank {
-    // --- Default parameters for the PageRank algorithm ---
-    const double DEFAULT_ALPHA = 0.85;
-    const double DEFAULT_CONVERGENCE = 0.00001;
-    const unsigned long DEFAULT_MAX_ITERATIONS = 10000;
-    const bool DEFAULT_NUMERIC = true; // Our input files use numeric IDs
-    const bool DEFAULT_UNDIRECTED = true;
-
-    /*
-     * A PageRank calculator class.
-     * Original source: https://github.com/louridas/pagerank/tree/master
-     * Modified to fit the project's needs (memory calculation, etc.).
-     */
-    class Table {
-    private:
-        double alpha;
-        double convergence;
-        unsigned long max_iterations;
-        bool undirected;
-        bool hypergraph;
-
-        vector<vector<size_t>> rows;
-        vector<size_t> num_outgoing;
-        map<string, size_t> nodes_to_idx;
-        map<size_t, string> idx_to_nodes;
-        vector<double> pr;
-
-        void trim(string &str) {
-            size_t startpos = str.find_first_not_of(" \t");
-            if (string::npos == startpos) {
-                str = "";
-            } else {
-                str = str.substr(startpos, str.find_last_not_of(" \t") - startpos + 1);
-            }
-        }
-
-        template <class Vector, class T>
-        bool insert_into_vector(Vector& v, const T& t) {
-            typename Vector::iterator i = lower_bound(v.begin(), v.end(), t);
-            if (i == v.end() || t < *i) {
-                v.insert(i, t);
-                return true;
-            }
-            return false;
-        }
-
-        void reset() {
-            num_outgoing.clear();
-            rows.clear();
-            nodes_to_idx.clear();
-            idx_to_nodes.clear();
-            pr.clear();
-        }
-
-        size_t insert_mapping(const string &key) {
-            auto it = nodes_to_idx.find(key);
-            if (it != nodes_to_idx.end()) {
-                return it->second;
-            }
-            size_t index = nodes_to_idx.size();
-            nodes_to_idx[key] = index;
-            idx_to_nodes[index] = key;
-            return index;
-        }
-
-        void add_arc(size_t from, size_t to) {
-            size_t max_dim = max(from, to);
-            if (rows.size() <= max_dim) {
-                rows.resize(max_dim + 1);
-                num_outgoing.resize(max_dim + 1);
-            }
-            if (insert_into_vector(rows[to], from)) {
-                num_outgoing[from]++;
-            }
-        }
-
-    public:
-        Table(double a = DEFAULT_ALPHA, double c = DEFAULT_CONVERGENCE, size_t i = DEFAULT_MAX_ITERATIONS)
-            : alpha(a), convergence(c), max_iterations(i), undirected(DEFAULT_UNDIRECTED), hypergraph(false) {}
-
-        void set_undirected(bool u) { undirected = u; }
-        void set_hypergraph(bool h) { hypergraph = h; }
-
-        int read_file(const string &filename) {
-            reset();
-            ifstream infile(filename.c_str());
-            if (!infile) {
-                cerr << "Error: Cannot open file " << filename << endl;
-                return 1;
-            }
-
-            string line;
-            if (!hypergraph) {
-                getline(infile, line); // Skip header line in .graph files
-            }
-
-            size_t linenum = 0;
-            while (getline(infile, line)) {
-                if (line.empty()) continue;
-                stringstream buffer(line);
-
-                if (hypergraph) {
-                    string hyperedge_node_str = to_string(MAXN + linenum);
-                    size_t hyperedge_idx = insert_mapping(hyperedge_node_str);
-                    string protein_node_str;
-                    while (buffer >> protein_node_str) {
-                        size_t protein_idx = insert_mapping(protein_node_str);
-                        add_arc(protein_idx, hyperedge_idx);
-                        add_arc(hyperedge_idx, protein_idx);
-                    }
-                } else {
-                    string from_str, to_str;
-                    buffer >> from_str >> to_str;
-                    size_t from_idx = insert_mapping(from_str);
-                    size_t to_idx = insert_mapping(to_str);
-                    add_arc(from_idx, to_idx);
-                    if (undirected) {
-                        add_arc(to_idx, from_idx);
-                    }
-                }
-                linenum++;
-            }
-            return 0;
+// --profile times phases and kernels and writes <output>.profile.json
+Profiler profile;
+
+// Prints the iteration count and the L1 residual of every iteration
+void report_convergence(const pageRank::Table& calculator, pageRank::Solver solver) {
+    const auto& residuals = calculator.get_residuals();
+    cout << "Solver: " << pageRank::SOLVER_NAMES[solver] << ", " << residuals.size() << " iterations" << endl;
+    cout << "Residuals:" << scientific << setprecision(3);
+    for (double r : residuals) cout << " " << r;
+    cout << endl;
+}
+
+// Reads a dataset into `calculator` as two measured phases: parsing the file
+// (load) and laying out the in-edge rows (build). The parsed graph is dropped
+// once the calculator holds its own copy. A stored graph is renumbered by
+// `order` first; `reordering` receives the permutation.
+void load_calculator(pageRank::Table& calculator, const string& path, int hyperedge_base, bool clique_view,
+                     bool use_cache, VertexOrder order, Reordering& reordering) {
+    reordering = Reordering();
+    IdMap mapping;
+    profile.begin("load");
+    if (clique_view) {
+        CliqueView view;
+        load_clique_view(path, hyperedge_base, use_cache, mapping, view);
+        profile.begin("build");
+        calculator.load_clique(std::move(view), std::move(mapping));
+        return;
+    }
+    CSRGraph graph;
+    vector<char> protein;
+    int hyperedges = load_dataset(path, hyperedge_base, use_cache, mapping, graph, protein);
+    profile.begin("build");
+    reordering = reorder_dataset(order, mapping, graph, protein);
+    cout << reordering.report();
+    calculator.load_graph(graph, std::move(mapping), max(hyperedges, 0));
+}
+
+// Runs PageRank on the graph loaded in `calculator`. With a state path, a
+// rank vector saved by an earlier run is refined incrementally instead;
+// returns the number of pushes of that warm start, or -1 if it did a full run.
+long long compute_pagerank(pageRank::Table& calculator, const string& state_path) {
+    if (!state_path.empty() && calculator.load_state(state_path)) {
+        long long pushes = calculator.update_pagerank();
+        if (pushes >= 0) return pushes;
+    }
+    calculator.calculate_pagerank();
+    return -1;
+}
+
+// Builds the columns of the personalized mode for the graph loaded in
+// `calculator`: one per (seed set, alpha) pair, or one uniform column per alpha
+// when no seed sets are given. Seeds missing from the graph (or hyperedge
+// nodes, with `proteins_only`) are dropped; sets left empty are skipped.
+vector<pageRank::Personalization> make_columns(const pageRank::Table& calculator, const vector<SeedSet>& seed_sets,
+                                               const vector<double>& alphas, bool proteins_only, int& skipped) {
+    vector<pageRank::Personalization> columns;
+    const auto& mapping = calculator.get_ids();
+    skipped = 0;
+    auto label = [](string name, double alpha) {
+        for (char& ch : name)
+            if (isspace((unsigned char)ch)) ch = '_';
+        ostringstream out;
+        out << name << "@" << alpha;
+        return out.str();
+    };
+    if (seed_sets.empty()) {
+        for (double a : alphas) columns.push_back({label("uniform", a), a, {}});
+        return columns;
+    }
+    for (const auto& set : seed_sets) {
+        vector<int> seeds;
+        for (int id : set.members) {
+            int idx = mapping.find(id);
+            if (idx != IdMap::NONE && (!proteins_only || id < MAXN)) seeds.push_back(idx);
         }
-
-        void calculate_pagerank() {
-            size_t num_rows = rows.size();
-            if (num_rows == 0) return;
-
-            pr.assign(num_rows, 1.0 / num_rows);
-            vector<double> old_pr;
-            double diff = 1;
-            unsigned long num_iterations = 0;
-
-            while (diff > convergence && num_iterations < max_iterations) {
-                old_pr = pr;
-                double dangling_pr_sum = 0;
-                for (size_t k = 0; k < num_rows; ++k) {
-                    if (num_outgoing[k] == 0) {
-                        dangling_pr_sum += old_pr[k];
-                    }
-                }
-
-                for (size_t i = 0; i < num_rows; ++i) {
-                    double h = 0.0;
-                    for (size_t incoming_node : rows[i]) {
-                        h += old_pr[incoming_node] / num_outgoing[incoming_node];
-                    }
-                    pr[i] = alpha * (h + dangling_pr_sum / num_rows) + (1.0 - alpha) / num_rows;
-                }
-
-                diff = 0;
-                for (size_t i = 0; i < num_rows; ++i) {
-                    diff += fabs(pr[i] - old_pr[i]);
-                }
-                num_iterations++;
-            }
+        sort(seeds.begin(), seeds.end());
+        seeds.erase(unique(seeds.begin(), seeds.end()), seeds.end());
+        if (seeds.empty()) {
+            ++skipped;
+            continue;
         }
-        
-        // --- Accessor methods to get results ---
-        const vector<double>& get_pagerank_vector() const { return pr; }
-        const map<size_t, string>& get_idx_to_node_map() const { return idx_to_nodes; }
-
-        // --- New method to calculate memory usage of this class instance ---
-        unsigned long long getMemoryUsage() const {
-            unsigned long long totalSize = 0;
-            // Memory for vector<vector<size_t>> rows
-            for(const auto& row : rows) {
-                totalSize += row.capacity() * sizeof(size_t);
-            }
-            totalSize += rows.capacity() * sizeof(vector<size_t>);
-            // Other vectors
-            totalSize += num_outgoing.capacity() * sizeof(size_t);
-            totalSize += pr.capacity() * sizeof(double);
-            // Memory for maps (estimation)
-            totalSize += nodes_to_idx.size() * (sizeof(string) + sizeof(size_t) + 3 * sizeof(void*));
-            totalSize += idx_to_nodes.size() * (sizeof(size_t) + sizeof(string) + 3 * sizeof(void*));
-            return totalSize;
+        for (double a : alphas) columns.push_back({label(set.name, a), a, seeds});
+    }
+    return columns;
+}
+
+// Runs the personalized mode on the graph already loaded in `calculator` and
+// writes "memory time peak-RSS sweeps", a blank line, then one section per
+// block of rank vectors: an "id <label> ..." row and one row of ranks per
+// node, in load order, to out_fname. Each block goes to the file as soon as
+// it converges, so only one block of ranks is resident. Memory is measured
+// over this mode's run, with the loaded graph still resident.
+void run_personalized(pageRank::Table& calculator, const Reordering& reordering, const vector<SeedSet>& seed_sets,
+                      const vector<double>& alphas, size_t block, bool proteins_only, const string& name,
+                      const string& out_fname) {
+    // Room for the header line, which is only known once every block is done
+    const size_t HEADER_WIDTH = 96;
+    int skipped;
+    profile.reset();
+    const MemoryPhases& phases = profile.memory;
+    auto begin = chrono::high_resolution_clock::now();
+    profile.begin("compute");
+    vector<pageRank::Personalization> columns = make_columns(calculator, seed_sets, alphas, proteins_only, skipped);
+    ResultWriter out;
+    out.open(out_fname);
+    out.field(string(HEADER_WIDTH, ' ')).end_line().end_line();
+    const auto& mapping = calculator.get_ids();
+    auto write_block = [&](size_t first, size_t k, const double* ranks, size_t stride) {
+        out.field("id");
+        for (size_t c = 0; c < k; ++c) out.field(columns[first + c].label);
+        out.end_line();
+        for (int x = 0; x < mapping.size(); ++x) {
+            int j = reordering.index(x);
+            if (proteins_only && mapping[j] >= MAXN) continue;
+            out.field(mapping[j]);
+            for (size_t c = 0; c < k; ++c) out.field(ranks[(size_t)j * stride + c]);
+            out.end_line();
         }
     };
-} // namespace pageRank
+    size_t sweeps;
+    {
+        Profiler::Scope scope(profile, profile.kernel("personalized"));
+        sweeps = calculator.calculate_personalized(columns, block, write_block);
+    }
+    auto end = chrono::high_resolution_clock::now();
+    double time = chrono::duration_cast<chrono::duration<double>>(end - begin).count();
+    profile.end();
+
+    ResultWriter header;
+    header.field(phases.heap_peak()).field(time).field(phases.rss_peak()).field(sweeps);
+    string line = header.data().substr(0, HEADER_WIDTH);
+    line.resize(HEADER_WIDTH, ' ');
+    out.patch(0, line);
+    if (!out.close()) cerr << "WARNING: Could not write " << out_fname << endl;
+
+    cout << "Personalized PageRank: " << columns.size() << " rank vectors in blocks of " << block << ", "
+         << sweeps << " sweeps";
+    if (skipped > 0) cout << " (" << skipped << " seed sets with no node in this graph skipped)";
+    cout << endl;
+    cout << "Memory Used: " << phases.heap_peak() << " Bytes (peak RSS " << phases.rss_peak() << " Bytes)" << endl;
+    cout << "Time Taken: " << fixed << setprecision(9) << time << " Seconds" << endl;
+    cout << "Memory by phase:" << endl << phases.report();
+    if (profile.enabled())
+        profile.write_json(out_fname.substr(0, out_fname.size() - 4) + ".profile.json", "pagerank-personalized",
+                           name, proteins_only ? "cmty" : "ungraph");
+}
+
+int main(int argc, char* argv[]) {
+    Options opts(argc, argv);
+    if (!opts.known({"alphas", "block", "clique-view", "no-cache", "profile", "reorder", "seeds", "solver", "state",
+                     "updates"}))
+        return 1;
+    // Parsed datasets are snapshotted to <input>.csr unless --no-cache is given
+    bool use_cache = !opts.has("no-cache");
+    // --clique-view computes the graph results from the hypergraph's implicit
+    // clique expansion instead of reading the materialized .graph file
+    bool clique_view = opts.has("clique-view");
+    // --solver=jacobi|gauss-seidel|aitken|adaptive picks the iteration scheme
+    pageRank::Solver solver = pageRank::JACOBI;
+    if (opts.has("solver") && !pageRank::parse_solver(opts.get("solver"), solver)) {
+        cerr << "ERROR: Unknown solver '" << opts.get("solver") << "'" << endl;
+        return 1;
+    }
+    // --seeds=<file> (a .gmt gene set library or one set of node IDs per line)
+    // and/or --alphas=a,b,... also compute personalized PageRank for every
+    // (seed set, alpha) pair, --block=k rank vectors per sweep
+    bool personalized = opts.has("seeds") || opts.has("alphas");
+    vector<SeedSet> seed_sets;
+    if (opts.has("seeds") && !load_seed_sets(opts.get("seeds"), seed_sets)) return 1;
+    vector<double> alphas;
+    {
+        stringstream list(opts.get("alphas"));
+        string item;
+        while (getline(list, item, ','))
+            if (!item.empty()) alphas.push_back(atof(item.c_str()));
+        if (alphas.empty()) alphas.push_back(pageRank::DEFAULT_ALPHA);
+    }
+    size_t block = pageRank::block_width(opts.get_int("block", pageRank::DEFAULT_BLOCK));
+    // --state keeps the rank vectors in Output/PageRank/<name>.<repr>.pagerank.state
+    // and warm-starts from them; --updates=<file> applies a batch of hyperedge
+    // insertions/deletions incrementally, to the hypergraph and to its clique
+    // expansion
+    bool use_state = opts.has("state");
+    // --reorder=rcm|gorder|degree renumbers every loaded graph for cache
+    // locality (see vertex-order.h); results keep their original IDs and order
+    VertexOrder reorder = VertexOrder::NONE;
+    if (opts.has("reorder") && !parse_vertex_order(opts.get("reorder"), reorder)) {
+        cerr << "ERROR: Unknown vertex order '" << opts.get("reorder") << "'" << endl;
+        return 1;
+    }
+    HyperedgeBatch batch;
+    if (opts.has("updates") && !read_hyperedge_batch(opts.get("updates"), batch)) return 1;
+    if (!batch.empty() && clique_view)
+        cout << "INFO: --clique-view has no stored graph to update, so --updates only applies to the hypergraph." << endl;
+    if (opts.has("profile")) profile.enable();
 
-int main() {
     string output_dir_name = "Output/PageRank/";
     cout << "INFO: This script will save results to '" << output_dir_name << "'." << endl;
     cout << "INFO: Please ensure this directory exists." << endl;
@@ -215,7 +233,6 @@ int main() {
     cin.tie(NULL);
 
     ifstream fin;
-    ofstream fout;
 
     for (const auto& s : init) {
         fin.open(s); // Uses relative path
@@ -245,46 +262,100 @@ int main() {
             pageRank::Table calculator;
             calculator.set_undirected(true);
             calculator.set_hypergraph(false);
+            calculator.set_cache(use_cache);
+            calculator.set_solver(solver);
 
+            profile.reset();
+            const MemoryPhases& phases = profile.memory;
             auto begin = chrono::high_resolution_clock::now();
-            calculator.read_file(graphs[i]); // Using relative path from init file
-            calculator.calculate_pagerank();
+            Reordering reordering;
+            if (clique_view)
+                load_calculator(calculator, hypergraphs[i], MAXN, true, use_cache, reorder, reordering);
+            else
+                load_calculator(calculator, graphs[i], -1, false, use_cache, reorder, reordering); // Using relative path from init file
+            profile.begin("compute");
+            string state_fname = use_state ? output_dir_name + names[i] + ".ungraph.pagerank.state" : "";
+            long long pushes;
+            {
+                Profiler::Scope scope(profile, profile.kernel("pagerank"));
+                pushes = compute_pagerank(calculator, state_fname);
+            }
+            // The clique expansion of the update batch, read off the hypergraph
+            bool update_graph = !batch.empty() && !clique_view;
+            long long update_pushes = 0;
+            double update_time = 0;
+            if (update_graph) {
+                auto update_begin = chrono::high_resolution_clock::now();
+                IdMap hyper_ids;
+                CSRGraph hyper;
+                vector<char> hyper_protein;
+                load_dataset(hypergraphs[i], MAXN, use_cache, hyper_ids, hyper, hyper_protein);
+                Profiler::Scope scope(profile, profile.kernel("update"));
+                update_pushes = calculator.update_cliques(hyper, hyper_ids, batch);
+                auto update_end = chrono::high_resolution_clock::now();
+                update_time = chrono::duration_cast<chrono::duration<double>>(update_end - update_begin).count();
+            }
             auto end = chrono::high_resolution_clock::now();
             double time = chrono::duration_cast<chrono::duration<double>>(end - begin).count();
-            
-            unsigned long long memory = calculator.getMemoryUsage();
+            profile.begin("output");
+            unsigned long long memory = phases.heap_peak(), rss = phases.rss_peak();
 
             cout << "For graph representation:" << endl;
-            cout << "Memory Used: " << memory << " Bytes" << endl;
+            cout << "Memory Used: " << memory << " Bytes (peak RSS " << rss << " Bytes)" << endl;
             cout << "Time Taken: " << fixed << setprecision(9) << time << " Seconds" << endl;
+            if (pushes >= 0)
+                cout << "Warm start from " << state_fname << ": " << pushes << " pushes" << endl;
+            else
+                report_convergence(calculator, solver);
+            if (update_graph)
+                cout << "Incremental update: +" << batch.inserted.size() << " -" << batch.deleted.size() << " hyperedges, "
+                     << update_pushes << " pushes in " << fixed << setprecision(9) << update_time << " Seconds" << endl;
+            if (use_state && !calculator.save_state(state_fname))
+                cerr << "WARNING: Could not write " << state_fname << endl;
 
             string out_fname = output_dir_name + names[i] + ".ungraph.pagerank.txt";
-            fout.open(out_fname);
-            fout << memory << " " << fixed << setprecision(9) << time << endl << endl;
+            ResultWriter out;
+            // Sweeps of a cold start, pushes of a warm start and of the update
+            out.field(memory).field(time).field(rss).field(calculator.get_residuals().size());
+            out.field(max(pushes, 0LL) + update_pushes).end_line().end_line();
 
             const auto& ranks = calculator.get_pagerank_vector();
-            const auto& mapping = calculator.get_idx_to_node_map();
+            const auto& mapping = calculator.get_ids();
             double max_rank = 0.0;
             
-            for (size_t j = 0; j < ranks.size(); ++j) {
-                const string& node_name = mapping.at(j);
-                fout << node_name << " " << ranks[j] << endl;
+            for (size_t k = 0; k < ranks.size(); ++k) {
+                int j = reordering.index(k);
+                // Nodes the update left without edges are not in the graph any more
+                if (update_graph && calculator.get_degree(j) == 0) continue;
+                out.row(mapping[j], ranks[j]);
                 if (ranks[j] > max_rank) {
                     max_rank = ranks[j];
                 }
             }
-            fout.close();
+            out.save(out_fname);
 
             cout << "The node(s) with the greatest PageRank are ";
             bool first = true;
-            for (size_t j = 0; j < ranks.size(); ++j) {
+            for (size_t k = 0; k < ranks.size(); ++k) {
+                int j = reordering.index(k);
                 if (fabs(ranks[j] - max_rank) < epsilon) {
                     if (!first) cout << ", ";
-                    cout << mapping.at(j);
+                    cout << mapping[j];
                     first = false;
                 }
             }
-            cout << ".\n" << endl;
+            cout << "." << endl;
+            profile.end();
+            cout << "Memory by phase:" << endl << phases.report() << endl;
+            if (profile.enabled())
+                profile.write_json(output_dir_name + names[i] + ".ungraph.pagerank.profile.json", "pagerank", names[i],
+                                   "ungraph");
+
+            if (personalized) {
+                run_personalized(calculator, reordering, seed_sets, alphas, block, false, names[i],
+                                 output_dir_name + names[i] + ".ungraph.ppr.txt");
+                cout << endl;
+            }
         }
         
         // ===================================================================
@@ -294,50 +365,94 @@ int main() {
             pageRank::Table calculator;
             calculator.set_undirected(true); // Our bipartite model is undirected
             calculator.set_hypergraph(true);
+            calculator.set_cache(use_cache);
+            calculator.set_solver(solver);
 
+            profile.reset();
+            const MemoryPhases& phases = profile.memory;
             auto begin = chrono::high_resolution_clock::now();
-            calculator.read_file(hypergraphs[i]);
-            calculator.calculate_pagerank();
+            Reordering reordering;
+            load_calculator(calculator, hypergraphs[i], MAXN, false, use_cache, reorder, reordering);
+            profile.begin("compute");
+            string state_fname = use_state ? output_dir_name + names[i] + ".cmty.pagerank.state" : "";
+            long long pushes;
+            {
+                Profiler::Scope scope(profile, profile.kernel("pagerank"));
+                pushes = compute_pagerank(calculator, state_fname);
+            }
+            // The output reflects the hypergraph after the update batch
+            long long update_pushes = 0;
+            double update_time = 0;
+            if (!batch.empty()) {
+                auto update_begin = chrono::high_resolution_clock::now();
+                Profiler::Scope scope(profile, profile.kernel("update"));
+                update_pushes = calculator.update_hyperedges(batch);
+                auto update_end = chrono::high_resolution_clock::now();
+                update_time = chrono::duration_cast<chrono::duration<double>>(update_end - update_begin).count();
+            }
             auto end = chrono::high_resolution_clock::now();
             double time = chrono::duration_cast<chrono::duration<double>>(end - begin).count();
+            profile.begin("output");
+            unsigned long long memory = phases.heap_peak(), rss = phases.rss_peak();
 
-            unsigned long long memory = calculator.getMemoryUsage();
-            
             cout << "For hypergraph representation:" << endl;
-            cout << "Memory Used: " << memory << " Bytes" << endl;
+            cout << "Memory Used: " << memory << " Bytes (peak RSS " << rss << " Bytes)" << endl;
             cout << "Time Taken: " << fixed << setprecision(9) << time << " Seconds" << endl;
+            if (pushes >= 0)
+                cout << "Warm start from " << state_fname << ": " << pushes << " pushes" << endl;
+            else
+                report_convergence(calculator, solver);
+            if (!batch.empty())
+                cout << "Incremental update: +" << batch.inserted.size() << " -" << batch.deleted.size() << " hyperedges, "
+                     << update_pushes << " pushes in " << fixed << setprecision(9) << update_time << " Seconds" << endl;
+            if (use_state && !calculator.save_state(state_fname))
+                cerr << "WARNING: Could not write " << state_fname << endl;
 
             string out_fname = output_dir_name + names[i] + ".cmty.pagerank.txt";
-            fout.open(out_fname);
-            fout << memory << " " << fixed << setprecision(9) << time << endl << endl;
+            ResultWriter out;
+            // Sweeps of a cold start, pushes of a warm start and of the update
+            out.field(memory).field(time).field(rss).field(calculator.get_residuals().size());
+            out.field(max(pushes, 0LL) + update_pushes).end_line().end_line();
 
             const auto& ranks = calculator.get_pagerank_vector();
-            const auto& mapping = calculator.get_idx_to_node_map();
+            const auto& mapping = calculator.get_ids();
             double max_rank = 0.0;
 
-            for (size_t j = 0; j < ranks.size(); ++j) {
-                const string& node_name = mapping.at(j);
-                // Only consider original protein nodes for output and max rank
-                if (stoll(node_name) < MAXN) {
-                    fout << node_name << " " << ranks[j] << endl;
+            for (size_t k = 0; k < ranks.size(); ++k) {
+                int j = reordering.index(k);
+                // Only consider original protein nodes for output and max rank,
+                // and not the ones the update left outside every hyperedge
+                if (mapping[j] < MAXN && (batch.empty() || calculator.get_degree(j) > 0)) {
+                    out.row(mapping[j], ranks[j]);
                     if (ranks[j] > max_rank) {
                         max_rank = ranks[j];
                     }
                 }
             }
-            fout.close();
+            out.save(out_fname);
 
             cout << "The node(s) with the greatest PageRank are ";
             bool first = true;
-            for (size_t j = 0; j < ranks.size(); ++j) {
-                 const string& node_name = mapping.at(j);
-                if (stoll(node_name) < MAXN && fabs(ranks[j] - max_rank) < epsilon) {
+            for (size_t k = 0; k < ranks.size(); ++k) {
+                int j = reordering.index(k);
+                if (mapping[j] < MAXN && fabs(ranks[j] - max_rank) < epsilon) {
                     if (!first) cout << ", ";
-                    cout << node_name;
+                    cout << mapping[j];
                     first = false;
                 }
             }
-            cout << ".\n" << endl;
+            cout << "." << endl;
+            profile.end();
+            cout << "Memory by phase:" << endl << phases.report() << endl;
+            if (profile.enabled())
+                profile.write_json(output_dir_name + names[i] + ".cmty.pagerank.profile.json", "pagerank", names[i],
+                                   "cmty");
+
+            if (personalized) {
+                run_personalized(calculator, reordering, seed_sets, alphas, block, true, names[i],
+                                 output_dir_name + names[i] + ".cmty.ppr.txt");
+                cout << endl;
+            }
         }
 
         cout << string(80, '=') << endl;
@@ -0,0 +1,637 @@
+#ifndef PAGERANK_H
+#define PAGERANK_H
+
+#include <fstream>
+#include <string>
+#include <vector>
+#include <cmath>
+#include <iomanip>
+#include <algorithm>
+#include <numeric>
+#include <deque>
+#include "csr-graph.h"
+#include "id-map.h"
+#include "graph-cache.h"
+#include "graph-reader.h"
+#include "clique-view.h"
+#include "graph-updates.h"
+
+/*
+ * PageRank solver shared by pagerank-centrality.cpp and all-centrality.cpp:
+ * power iteration and its variants, personalized PageRank in blocks of rank
+ * vectors, and push-based incremental updates.
+ */
+namespace pageRank {
+    using namespace std;
+
+    // Original IDs from this base on are hyperedge nodes (MAXN in the programs)
+    const int HYPEREDGE_BASE = 4e6;
+
+    // --- Default parameters for the PageRank algorithm ---
+    const double DEFAULT_ALPHA = 0.85;
+    const double DEFAULT_CONVERGENCE = 0.00001;
+    const unsigned long DEFAULT_MAX_ITERATIONS = 10000;
+    const bool DEFAULT_NUMERIC = true; // Our input files use numeric IDs
+    const bool DEFAULT_UNDIRECTED = true;
+
+    // --- Iteration schemes for calculate_pagerank() ---
+    // JACOBI:        power iteration, every node pulls the previous sweep's ranks
+    // GAUSS_SEIDEL:  in-place sweeps, nodes later in a sweep see updated ranks
+    // EXTRAPOLATION: power iteration with an Aitken delta-squared step every
+    //                EXTRAPOLATION_PERIOD sweeps
+    // ADAPTIVE:      power iteration that stops recomputing nodes whose change
+    //                stayed below convergence / num_rows for two sweeps
+    enum Solver { JACOBI, GAUSS_SEIDEL, EXTRAPOLATION, ADAPTIVE };
+    const char* const SOLVER_NAMES[] = {"jacobi", "gauss-seidel", "aitken", "adaptive"};
+    const size_t EXTRAPOLATION_PERIOD = 10;
+    const size_t ADAPTIVE_RECHECK = 10;
+
+    // --- Personalized PageRank (calculate_personalized) ---
+    // One rank vector of a block: teleports to `seeds` (dense node indices,
+    // distinct; every node when empty) with damping factor `alpha`
+    struct Personalization {
+        string label;
+        double alpha;
+        vector<int> seeds;
+    };
+    const size_t DEFAULT_BLOCK = 16;
+    const size_t MAX_BLOCK = 32;
+
+    // Rounds a requested block width down to a supported power of two
+    inline size_t block_width(long long requested) {
+        size_t width = 1;
+        while (width * 2 <= MAX_BLOCK && (long long)width * 2 <= requested) width *= 2;
+        return width;
+    }
+
+    inline bool parse_solver(const string& name, Solver& solver) {
+        for (int k = 0; k < 4; ++k) {
+            if (name == SOLVER_NAMES[k]) {
+                solver = (Solver)k;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    /*
+     * A PageRank calculator class.
+     * Original source: https://github.com/louridas/pagerank/tree/master
+     * Modified to fit the project's needs (memory calculation, etc.).
+     */
+    class Table {
+    private:
+        double alpha;
+        double convergence;
+        unsigned long max_iterations;
+        bool undirected;
+        bool hypergraph;
+        bool use_cache;
+        Solver solver;
+
+        // In-edge CSR: the sources of the arcs into v, deduplicated and ascending
+        CSRGraph in_arcs;
+        vector<int> num_outgoing;
+        // Set instead of `in_arcs` when the graph is the hypergraph's implicit clique expansion
+        CliqueView clique;
+        IdMap ids;
+        vector<double> pr;
+        // pr[u] / num_outgoing[u], computed once per node and iteration
+        vector<double> contribution;
+        // L1 change of every iteration of the last calculate_pagerank()
+        vector<double> residuals;
+        // calculate_personalized(): the node-major working set of one block
+        vector<double> block_pr, block_next_pr, block_contribution, block_next_contribution;
+        // Incremental state (update_pagerank): scaled = alpha * P scaled +
+        // (1 - alpha) over the live nodes, so pr is scaled / sum(scaled), and the
+        // residual of that equation at every node
+        vector<double> scaled, residual;
+        int num_hyperedges = 0;
+
+        void reset() {
+            in_arcs.clear();
+            num_outgoing.clear();
+            clique = CliqueView();
+            ids.clear();
+            pr.clear();
+            contribution.clear();
+            residuals.clear();
+            scaled.clear();
+            residual.clear();
+            num_hyperedges = 0;
+        }
+
+        // Lays (to, from) arcs out as the in-edge CSR; sort + unique drops
+        // repeated arcs and leaves every row in ascending source order.
+        void build_rows(vector<pair<int, int>>& arcs) {
+            sort(arcs.begin(), arcs.end());
+            arcs.erase(unique(arcs.begin(), arcs.end()), arcs.end());
+            num_outgoing.assign(ids.size(), 0);
+            for (const auto& arc : arcs) {
+                num_outgoing[arc.second]++;
+            }
+            in_arcs.build(ids.size(), arcs, false);
+        }
+
+        // Sum of the contributions pulled into node i
+        double pull(CliqueView::Scanner& scan, bool implicit, size_t i) const {
+            double h = 0.0;
+            if (implicit) {
+                // Undirected: the in-neighbors are the neighbors
+                scan.neighbors(i, [&](int incoming_node) {
+                    h += contribution[incoming_node];
+                });
+            } else {
+                for (int incoming_node : in_arcs.neighbors(i)) {
+                    h += contribution[incoming_node];
+                }
+            }
+            return h;
+        }
+
+        // Recomputes every contribution from `pr` and returns the dangling mass
+        double refresh_contributions() {
+            double dangling_pr_sum = 0;
+            for (size_t k = 0; k < pr.size(); ++k) {
+                if (num_outgoing[k] == 0) {
+                    dangling_pr_sum += pr[k];
+                } else {
+                    contribution[k] = pr[k] / num_outgoing[k];
+                }
+            }
+            return dangling_pr_sum;
+        }
+
+        // Componentwise Aitken delta-squared step from three successive iterates,
+        // renormalized to a probability vector. Only components that are
+        // converging geometrically (successive changes shrinking, same sign) are
+        // extrapolated; the rest keep the latest iterate.
+        void extrapolate(const vector<double>& x0, const vector<double>& x1) {
+            double total = 0;
+            for (size_t i = 0; i < pr.size(); ++i) {
+                double d1 = x1[i] - x0[i], d2 = pr[i] - x1[i];
+                if (d1 != 0) {
+                    double ratio = d2 / d1;
+                    if (ratio > 0 && ratio < 0.99) {
+                        double y = pr[i] + d2 * ratio / (1 - ratio);
+                        if (y > 0) pr[i] = y;
+                    }
+                }
+                total += pr[i];
+            }
+            for (double& x : pr) x /= total;
+        }
+
+        // Nodes left without arcs by an update drop out of the ranking, as they
+        // would from a fresh read of the updated file
+        bool live(size_t i) const { return num_outgoing[i] > 0; }
+
+        // Seeds the incremental state from `pr` with one pass over the in-edges
+        void warm_start() {
+            size_t num_rows = in_arcs.size();
+            size_t num_live = 0;
+            for (size_t i = 0; i < num_rows; ++i) num_live += live(i);
+            scaled.assign(num_rows, 0);
+            for (size_t i = 0; i < min(num_rows, pr.size()); ++i)
+                if (live(i)) scaled[i] = pr[i] * num_live;
+            residual.assign(num_rows, 0);
+            for (size_t i = 0; i < num_rows; ++i) {
+                double h = 0;
+                for (int incoming_node : in_arcs.neighbors(i)) h += scaled[incoming_node] / num_outgoing[incoming_node];
+                residual[i] = (live(i) ? 1.0 - alpha : 0.0) + alpha * h - scaled[i];
+            }
+        }
+
+        // Adds the terms node u contributes to the residuals (sign = +1) or
+        // takes them back (sign = -1): its teleport and its share to every
+        // neighbor. Undirected graphs only, so out-neighbors = in-neighbors.
+        void spread(int u, double sign) {
+            if (!live(u)) return;
+            residual[u] += sign * (1.0 - alpha);
+            double share = sign * alpha * scaled[u] / num_outgoing[u];
+            for (int w : in_arcs.neighbors(u)) residual[w] += share;
+        }
+
+        // Gauss-Southwell push: settles residuals above `convergence` starting
+        // from `candidates`. That bounds the L1 error of pr by about
+        // convergence / (1 - alpha), the same accuracy calculate_pagerank()
+        // stops at. Returns the number of pushes.
+        size_t push_residuals(const vector<int>& candidates) {
+            double threshold = convergence;
+            vector<char> queued(scaled.size(), 0);
+            deque<int> queue;
+            for (int v : candidates) {
+                if (!queued[v] && fabs(residual[v]) > threshold) {
+                    queued[v] = 1;
+                    queue.push_back(v);
+                }
+            }
+            size_t pushes = 0;
+            while (!queue.empty()) {
+                int u = queue.front();
+                queue.pop_front();
+                queued[u] = 0;
+                double r = residual[u];
+                scaled[u] += r;
+                residual[u] = 0;
+                ++pushes;
+                if (!live(u)) continue;
+                double share = alpha * r / num_outgoing[u];
+                for (int w : in_arcs.neighbors(u)) {
+                    residual[w] += share;
+                    if (!queued[w] && fabs(residual[w]) > threshold) {
+                        queued[w] = 1;
+                        queue.push_back(w);
+                    }
+                }
+            }
+
+            double total = 0;
+            for (size_t i = 0; i < scaled.size(); ++i)
+                if (live(i)) total += scaled[i];
+            pr.assign(scaled.size(), 0);
+            for (size_t i = 0; i < scaled.size(); ++i)
+                if (live(i)) pr[i] = scaled[i] / total;
+            return pushes;
+        }
+
+        // One block of calculate_personalized(): columns [first, first + k) of
+        // `columns`, iterated as K node-major lanes. K is a compile-time width
+        // so the per-arc loop over the lanes is fully vectorized; lanes past k
+        // repeat the last column and are discarded.
+        template <size_t K, class F>
+        size_t iterate_block(const vector<Personalization>& columns, size_t first, size_t k,
+                             CliqueView::Scanner& scan, bool implicit, size_t num_rows, F& done) {
+            const Personalization* col[K];
+            double alphas[K];
+            for (size_t c = 0; c < K; ++c) {
+                col[c] = &columns[first + min(c, k - 1)];
+                alphas[c] = col[c]->alpha;
+            }
+
+            // Lanes that teleport to node i, as a CSR over the nodes
+            vector<pair<int, int>> pins;
+            for (size_t c = 0; c < k; ++c)
+                for (int s : col[c]->seeds)
+                    pins.push_back({s, (int)c});
+            CSRGraph seeded;
+            seeded.build(num_rows, pins, false);
+
+            // Start from the teleport vectors
+            block_pr.assign(num_rows * K, 0);
+            for (size_t c = 0; c < K; ++c) {
+                const vector<int>& seeds = col[c]->seeds;
+                if (seeds.empty()) {
+                    for (size_t i = 0; i < num_rows; ++i) block_pr[i * K + c] = 1.0 / num_rows;
+                } else {
+                    for (int s : seeds) block_pr[s * K + c] = 1.0 / seeds.size();
+                }
+            }
+            block_next_pr.assign(num_rows * K, 0);
+            block_contribution.assign(num_rows * K, 0);
+            block_next_contribution.assign(num_rows * K, 0);
+            double dangling[K] = {0};
+            for (size_t i = 0; i < num_rows; ++i) {
+                const double* x = &block_pr[i * K];
+                if (num_outgoing[i] == 0) {
+                    for (size_t c = 0; c < K; ++c) dangling[c] += x[c];
+                } else {
+                    for (size_t c = 0; c < K; ++c) block_contribution[i * K + c] = x[c] / num_outgoing[i];
+                }
+            }
+
+            size_t sweeps = 0;
+            while (sweeps < max_iterations) {
+                double uniform_jump[K], seed_jump[K], diff[K] = {0}, next_dangling[K] = {0};
+                for (size_t c = 0; c < K; ++c) {
+                    double jump = alphas[c] * dangling[c] + (1.0 - alphas[c]);
+                    size_t num_seeds = col[c]->seeds.size();
+                    uniform_jump[c] = num_seeds == 0 ? jump / num_rows : 0;
+                    seed_jump[c] = num_seeds == 0 ? 0 : jump / num_seeds;
+                }
+                const double* contribution_in = block_contribution.data();
+                for (size_t i = 0; i < num_rows; ++i) {
+                    double acc[K] = {0};
+                    auto add = [&](int incoming_node) {
+                        const double* from = contribution_in + (size_t)incoming_node * K;
+                        for (size_t c = 0; c < K; ++c) acc[c] += from[c];
+                    };
+                    if (implicit) {
+                        scan.neighbors(i, add);
+                    } else {
+                        for (int incoming_node : in_arcs.neighbors(i)) add(incoming_node);
+                    }
+                    double* x = &block_next_pr[i * K];
+                    const double* old = &block_pr[i * K];
+                    for (size_t c = 0; c < K; ++c) x[c] = alphas[c] * acc[c] + uniform_jump[c];
+                    for (int c : seeded.neighbors(i)) x[c] += seed_jump[c];
+                    for (size_t c = 0; c < K; ++c) diff[c] += fabs(x[c] - old[c]);
+                    if (num_outgoing[i] == 0) {
+                        for (size_t c = 0; c < K; ++c) next_dangling[c] += x[c];
+                    } else {
+                        double share = 1.0 / num_outgoing[i];
+                        double* out = &block_next_contribution[i * K];
+                        for (size_t c = 0; c < K; ++c) out[c] = x[c] * share;
+                    }
+                }
+                block_pr.swap(block_next_pr);
+                block_contribution.swap(block_next_contribution);
+                copy(next_dangling, next_dangling + K, dangling);
+                ++sweeps;
+                if (*max_element(diff, diff + k) <= convergence) break;
+            }
+
+            done(first, k, (const double*)block_pr.data(), K);
+            return sweeps;
+        }
+
+    public:
+        Table(double a = DEFAULT_ALPHA, double c = DEFAULT_CONVERGENCE, size_t i = DEFAULT_MAX_ITERATIONS)
+            : alpha(a), convergence(c), max_iterations(i), undirected(DEFAULT_UNDIRECTED), hypergraph(false), use_cache(true), solver(JACOBI) {}
+
+        void set_undirected(bool u) { undirected = u; }
+        void set_hypergraph(bool h) { hypergraph = h; }
+        void set_cache(bool c) { use_cache = c; }
+        void set_solver(Solver s) { solver = s; }
+
+        int read_file(const string &filename) {
+            reset();
+            vector<pair<int, int>> arcs;
+            // The bipartite hypergraph model is always undirected, and only
+            // undirected datasets go through the shared (symmetric) CSR cache
+            if (undirected || hypergraph) {
+                CSRGraph graph;
+                vector<char> protein;
+                IdMap mapping;
+                int hyperedges = load_dataset(filename, hypergraph ? HYPEREDGE_BASE : -1, use_cache, mapping, graph, protein);
+                if (hyperedges < 0) return 1;
+                load_graph(graph, std::move(mapping), hyperedges);
+                return 0;
+            } else {
+                vector<pair<int, int>> edges;
+                if (!load_graph_file(filename, ids, edges)) return 1;
+                arcs.reserve(edges.size());
+                for (const auto& [from_idx, to_idx] : edges)
+                    arcs.push_back({to_idx, from_idx});
+            }
+            build_rows(arcs);
+            return 0;
+        }
+
+        // Takes an undirected graph already in memory (e.g. loaded by another
+        // measure); `hyperedges` is the count load_dataset() returned for it.
+        void load_graph(const CSRGraph& graph, IdMap mapping, int hyperedges) {
+            reset();
+            ids = std::move(mapping);
+            num_hyperedges = hyperedges;
+            vector<pair<int, int>> arcs;
+            arcs.reserve(graph.num_arcs());
+            for (int from_idx = 0; from_idx < graph.size(); ++from_idx)
+                for (int to_idx : graph.neighbors(from_idx))
+                    arcs.push_back({to_idx, from_idx});
+            build_rows(arcs);
+        }
+
+        // Same for a clique-expansion view already in memory
+        void load_clique(CliqueView view, IdMap mapping) {
+            reset();
+            ids = std::move(mapping);
+            clique = std::move(view);
+            num_outgoing.resize(clique.size());
+            for (int v = 0; v < clique.size(); ++v)
+                num_outgoing[v] = clique.degree(v);
+        }
+
+        // Reads a .hypergraph file as its clique expansion without storing the
+        // pairwise edges; calculate_pagerank() then pulls through the view.
+        int read_clique_view(const string &filename) {
+            reset();
+            if (!load_clique_view(filename, HYPEREDGE_BASE, use_cache, ids, clique)) return 1;
+            num_outgoing.resize(clique.size());
+            for (int v = 0; v < clique.size(); ++v)
+                num_outgoing[v] = clique.degree(v);
+            return 0;
+        }
+
+        void calculate_pagerank() {
+            bool implicit = clique.size() > 0;
+            size_t num_rows = implicit ? clique.size() : in_arcs.size();
+            residuals.clear();
+            if (num_rows == 0) return;
+            CliqueView::Scanner scan(clique);
+
+            pr.assign(num_rows, 1.0 / num_rows);
+            contribution.assign(num_rows, 0);
+            double dangling_pr_sum = refresh_contributions();
+            vector<double> next_pr(num_rows), next_contribution(num_rows);
+            // Adaptive: 0 = active, 1 = settled for one sweep, 2 = frozen
+            vector<char> frozen(solver == ADAPTIVE ? num_rows : 0, 0);
+            vector<double> x0, x1;
+            double teleport = (1.0 - alpha) / num_rows;
+            double diff = 1;
+            bool full_sweep = true;
+
+            while ((diff > convergence || !full_sweep) && residuals.size() < max_iterations) {
+                // Adaptive: frozen nodes are rechecked every ADAPTIVE_RECHECK
+                // sweeps and once more before convergence is accepted
+                full_sweep = frozen.empty() || residuals.size() % ADAPTIVE_RECHECK == 0 || diff <= convergence;
+                diff = 0;
+                if (solver == GAUSS_SEIDEL) {
+                    // In place: later rows of the sweep already pull this sweep's values
+                    for (size_t i = 0; i < num_rows; ++i) {
+                        double rank = alpha * (pull(scan, implicit, i) + dangling_pr_sum / num_rows) + teleport;
+                        diff += fabs(rank - pr[i]);
+                        if (num_outgoing[i] == 0) {
+                            dangling_pr_sum += rank - pr[i];
+                        } else {
+                            contribution[i] = rank / num_outgoing[i];
+                        }
+                        pr[i] = rank;
+                    }
+                } else {
+                    // One fused pass: update, residual, and the next sweep's
+                    // contributions and dangling mass
+                    double next_dangling_pr_sum = 0;
+                    for (size_t i = 0; i < num_rows; ++i) {
+                        double rank = pr[i];
+                        if (full_sweep || frozen[i] < 2) {
+                            rank = alpha * (pull(scan, implicit, i) + dangling_pr_sum / num_rows) + teleport;
+                            diff += fabs(rank - pr[i]);
+                            // Adaptive: stop updating nodes whose rank has settled
+                            // for two sweeps in a row
+                            if (!frozen.empty()) {
+                                frozen[i] = fabs(rank - pr[i]) < convergence / num_rows ? frozen[i] + 1 : 0;
+                            }
+                        }
+                        next_pr[i] = rank;
+                        if (num_outgoing[i] == 0) {
+                            next_dangling_pr_sum += rank;
+                        } else {
+                            next_contribution[i] = rank / num_outgoing[i];
+                        }
+                    }
+                    pr.swap(next_pr);
+                    contribution.swap(next_contribution);
+                    dangling_pr_sum = next_dangling_pr_sum;
+                }
+                residuals.push_back(diff);
+
+                if (solver == EXTRAPOLATION) {
+                    size_t phase = residuals.size() % EXTRAPOLATION_PERIOD;
+                    // Iterates two sweeps apart, so the period-2 oscillation of
+                    // bipartite graphs does not mask the geometric decay
+                    if (phase == EXTRAPOLATION_PERIOD - 4) {
+                        x0 = pr;
+                    } else if (phase == EXTRAPOLATION_PERIOD - 2) {
+                        x1 = pr;
+                    } else if (phase == 0 && !x1.empty()) {
+                        extrapolate(x0, x1);
+                        dangling_pr_sum = refresh_contributions();
+                    }
+                }
+            }
+        }
+
+        /*
+         * Incremental PageRank on an undirected graph read by read_file().
+         * update_pagerank() refines the current `pr` (e.g. from load_state())
+         * with push-based residual propagation; update_edges(),
+         * update_hyperedges() and update_cliques() change the graph and only
+         * adjust the residuals of the nodes whose rows changed and their
+         * neighbors, so a small batch is settled by a few local pushes. They
+         * return the number of pushes, or -1 for a clique view or a directed
+         * graph.
+         */
+        long long update_pagerank() {
+            if (in_arcs.size() == 0 || !(undirected || hypergraph)) return -1;
+            warm_start();
+            residuals.clear();
+            vector<int> all(in_arcs.size());
+            iota(all.begin(), all.end(), 0);
+            return push_residuals(all);
+        }
+
+        // Applies a batch of edge changes (see graph-updates.h)
+        long long update_edges(const GraphChanges& changes) {
+            if (in_arcs.size() == 0 || !(undirected || hypergraph)) return -1;
+            // The first update settles the whole vector once; later ones
+            // start from a state that is already within the threshold
+            if (scaled.size() != (size_t)in_arcs.size()) {
+                warm_start();
+                vector<int> all(in_arcs.size());
+                iota(all.begin(), all.end(), 0);
+                push_residuals(all);
+            }
+            size_t num_rows = max<size_t>(changes.num_nodes, in_arcs.size());
+            num_outgoing.resize(num_rows, 0);
+            scaled.resize(num_rows, 0);
+            residual.resize(num_rows, 0);
+
+            // Swap the old terms of the touched nodes for the new ones
+            vector<int> endpoints, candidates;
+            for (const auto& [u, v] : changes.added) endpoints.insert(endpoints.end(), {u, v});
+            for (const auto& [u, v] : changes.removed) endpoints.insert(endpoints.end(), {u, v});
+            sort(endpoints.begin(), endpoints.end());
+            endpoints.erase(unique(endpoints.begin(), endpoints.end()), endpoints.end());
+            for (int u : endpoints) {
+                if (u >= in_arcs.size()) continue;
+                spread(u, -1);
+                for (int w : in_arcs.neighbors(u)) candidates.push_back(w);
+            }
+            apply_changes(in_arcs, changes);
+            for (int u : endpoints) {
+                num_outgoing[u] = in_arcs.degree(u);
+                spread(u, +1);
+                candidates.push_back(u);
+                for (int w : in_arcs.neighbors(u)) candidates.push_back(w);
+            }
+            return push_residuals(candidates);
+        }
+
+        // Hypergraph mode: applies a batch of hyperedge insertions/deletions
+        long long update_hyperedges(const HyperedgeBatch& batch) {
+            if (!hypergraph) return -1;
+            GraphChanges changes;
+            bipartite_changes(in_arcs, ids, HYPEREDGE_BASE, num_hyperedges, batch, changes);
+            return update_edges(changes);
+        }
+
+        // Graph mode: applies the clique expansion of the same batch, with
+        // the hyperedges read from `bipartite` (see clique_changes())
+        long long update_cliques(const CSRGraph& bipartite, const IdMap& bipartite_ids, const HyperedgeBatch& batch) {
+            if (hypergraph) return -1;
+            GraphChanges changes;
+            clique_changes(bipartite, bipartite_ids, HYPEREDGE_BASE, batch, ids, changes);
+            return update_edges(changes);
+        }
+
+        // Writes "id rank" for every live node, at full precision
+        bool save_state(const string& path) const {
+            ofstream out(path);
+            if (!out.is_open()) return false;
+            out << setprecision(17);
+            for (size_t i = 0; i < pr.size(); ++i)
+                if (pr[i] > 0) out << ids[i] << " " << pr[i] << "\n";
+            return (bool)out;
+        }
+
+        // Reads a save_state() file as the current `pr` (unknown IDs are
+        // ignored, nodes missing from the file start at 0) for update_pagerank()
+        bool load_state(const string& path) {
+            ifstream in(path);
+            if (!in.is_open()) return false;
+            pr.assign(ids.size(), 0);
+            int id;
+            double rank;
+            while (in >> id >> rank) {
+                int idx = ids.find(id);
+                if (idx != IdMap::NONE) pr[idx] = rank;
+            }
+            scaled.clear();
+            return true;
+        }
+
+        /*
+         * Personalized PageRank for many teleport vectors at once. Columns are
+         * iterated in blocks of `block` rank vectors (1, 2, 4, 8, 16 or 32)
+         * stored node-major, so one traversal of the in-edges serves the whole
+         * block and the inner loops run over contiguous lanes. Each block is a
+         * Jacobi iteration run until every column's L1 change is below
+         * convergence; dangling mass teleports like the rest. Each finished
+         * block is handed to `done(first, k, ranks, stride)`, where column
+         * first + c of node i is ranks[i * stride + c], so only one block of
+         * ranks is ever resident. Returns the total number of sweeps.
+         */
+        template <class F>
+        size_t calculate_personalized(const vector<Personalization>& columns, size_t block, F done) {
+            bool implicit = clique.size() > 0;
+            size_t num_rows = implicit ? clique.size() : in_arcs.size();
+            size_t num_columns = columns.size();
+            if (num_rows == 0 || num_columns == 0) return 0;
+            CliqueView::Scanner scan(clique);
+            block = block_width((long long)block);
+
+            size_t sweeps = 0;
+            for (size_t first = 0; first < num_columns; first += block) {
+                size_t k = min(block, num_columns - first);
+                switch (block) {
+                    case 1: sweeps += iterate_block<1>(columns, first, k, scan, implicit, num_rows, done); break;
+                    case 2: sweeps += iterate_block<2>(columns, first, k, scan, implicit, num_rows, done); break;
+                    case 4: sweeps += iterate_block<4>(columns, first, k, scan, implicit, num_rows, done); break;
+                    case 8: sweeps += iterate_block<8>(columns, first, k, scan, implicit, num_rows, done); break;
+                    case 16: sweeps += iterate_block<16>(columns, first, k, scan, implicit, num_rows, done); break;
+                    default: sweeps += iterate_block<32>(columns, first, k, scan, implicit, num_rows, done); break;
+                }
+            }
+            return sweeps;
+        }
+
+        // --- Accessor methods to get results ---
+        const vector<double>& get_pagerank_vector() const { return pr; }
+        const IdMap& get_ids() const { return ids; }
+        int get_degree(size_t i) const { return num_outgoing[i]; }
+        const vector<double>& get_residuals() const { return residuals; }
+    };
+} // namespace pageRank
+
+#endif // PAGERANK_H
@@ -0,0 +1,264 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <vector>
+#ifdef __linux__
+#include <unistd.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <linux/perf_event.h>
+#endif
+#include "memory-tracker.h"
+
+/*
+ * Per-phase and per-kernel profile of one centrality run, written as JSON
+ * next to the output files when a program is given --profile.
+ *
+ * Phases (load, build, compute, output) are consecutive and always drive the
+ * MemoryPhases measurement; with profiling on they are also timed. Kernels are
+ * named regions inside them (a BFS, Brandes' backward pass, progress output,
+ * a PageRank sweep loop) whose time and call count accumulate across calls.
+ *
+ * Hardware counters (cycles, instructions, last-level cache read misses,
+ * branch misses) come from perf_event_open with `inherit` set, so worker
+ * threads count toward the region that spawned and joined them. Where the
+ * kernel refuses (perf_event_paranoid, containers), and on systems other than
+ * Linux, the counters are reported as null and only times are kept.
+ *
+ * When profiling is off, a Scope or Timer is one branch on a bool.
+ */
+class Profiler {
+public:
+    static constexpr int NUM_COUNTERS = 4;
+    static constexpr const char* COUNTER_NAMES[NUM_COUNTERS] = {"cycles", "instructions", "llc_misses",
+                                                                 "branch_misses"};
+
+    struct Sample {
+        double seconds = 0;
+        unsigned long long calls = 0;
+        uint64_t counts[NUM_COUNTERS] = {0};
+    };
+
+    struct Kernel {
+        std::string name;
+        Sample total;
+        bool counted = false;   // timed by a Scope, so the counters apply
+    };
+
+    // Time-only accumulator for regions on worker threads, where the
+    // process-wide counters cannot be attributed; merge with add().
+    struct Tally {
+        double seconds = 0;
+        unsigned long long calls = 0;
+    };
+
+    MemoryPhases memory;
+
+    ~Profiler() {
+#ifdef __linux__
+        for (int fd : fds)
+            if (fd >= 0) close(fd);
+#endif
+    }
+
+    // Turns profiling on; hardware counters are opened on first use.
+    void enable() {
+        on = true;
+        if (fds.empty()) open_counters();
+    }
+
+    bool enabled() const { return on; }
+    bool has_counters() const { return counting; }
+
+    // Starts a new run: forgets phases, kernels and memory peaks.
+    void reset() {
+        memory = MemoryPhases();
+        phases.clear();
+        kernels.clear();
+        phase_open = false;
+    }
+
+    // Closes the running phase and opens `name`.
+    void begin(const std::string& name) {
+        end();
+        memory.begin(name);
+        if (!on) return;
+        phases.push_back({name, Sample(), true});
+        phase_open = true;
+        start(phase_start, phase_counts);
+    }
+
+    void end() {
+        memory.end();
+        if (!phase_open) return;
+        stop(phase_start, phase_counts, phases.back().total);
+        phase_open = false;
+    }
+
+    // Accumulator for kernel `name`; look it up once outside hot loops. While
+    // profiling is off every name maps to one scratch entry.
+    Kernel& kernel(const std::string& name) {
+        if (!on) return scratch;
+        for (auto& k : kernels)
+            if (k.name == name) return k;
+        kernels.push_back({name, Sample(), false});
+        return kernels.back();
+    }
+
+    // Adds a worker-thread tally to kernel `name`.
+    void add(const std::string& name, const Tally& tally) {
+        if (!on) return;
+        std::lock_guard<std::mutex> lock(merge);
+        Kernel& k = kernel(name);
+        k.total.seconds += tally.seconds;
+        k.total.calls += tally.calls;
+    }
+
+    // Times one call of a kernel on the thread that owns the profiler,
+    // counters included.
+    class Scope {
+    public:
+        Scope(Profiler& p, Kernel& k) : profiler(p), kernel(k), active(p.on) {
+            if (active) profiler.start(begin, counts);
+        }
+        ~Scope() {
+            if (!active) return;
+            Sample s;
+            profiler.stop(begin, counts, s);
+            kernel.total.seconds += s.seconds;
+            kernel.total.calls += 1;
+            kernel.counted = true;
+            for (int c = 0; c < NUM_COUNTERS; ++c) kernel.total.counts[c] += s.counts[c];
+        }
+    private:
+        Profiler& profiler;
+        Kernel& kernel;
+        bool active;
+        std::chrono::steady_clock::time_point begin;
+        uint64_t counts[NUM_COUNTERS];
+    };
+
+    // Times one call of a region on a worker thread into a Tally.
+    class Timer {
+    public:
+        Timer(bool enabled, Tally& t) : tally(t), active(enabled) {
+            if (active) begin = std::chrono::steady_clock::now();
+        }
+        ~Timer() {
+            if (!active) return;
+            tally.seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+            tally.calls += 1;
+        }
+    private:
+        Tally& tally;
+        bool active;
+        std::chrono::steady_clock::time_point begin;
+    };
+
+    // Writes {"program", "dataset", "representation", "counters", "phases",
+    // "kernels"} to `path`; phases carry their heap and peak RSS as well.
+    bool write_json(const std::string& path, const std::string& program, const std::string& dataset,
+                    const std::string& representation) const {
+        FILE* f = fopen(path.c_str(), "w");
+        if (!f) return false;
+        fprintf(f, "{\n  \"program\": \"%s\",\n  \"dataset\": \"%s\",\n  \"representation\": \"%s\",\n",
+                program.c_str(), dataset.c_str(), representation.c_str());
+        fprintf(f, "  \"counters\": %s,\n  \"phases\": [", counting ? "true" : "false");
+        const auto& measured = memory.list();
+        for (size_t p = 0; p < phases.size(); ++p) {
+            fprintf(f, "%s\n    {", p ? "," : "");
+            write_sample(f, phases[p], false);
+            if (p < measured.size())
+                fprintf(f, ", \"heap_bytes\": %llu, \"peak_rss_bytes\": %llu", measured[p].heap, measured[p].rss);
+            fprintf(f, "}");
+        }
+        fprintf(f, "\n  ],\n  \"kernels\": [");
+        for (size_t k = 0; k < kernels.size(); ++k) {
+            fprintf(f, "%s\n    {", k ? "," : "");
+            write_sample(f, kernels[k], true);
+            fprintf(f, "}");
+        }
+        fprintf(f, "\n  ]\n}\n");
+        return fclose(f) == 0;
+    }
+
+private:
+    bool on = false;
+    bool counting = false;
+    std::vector<int> fds;
+    std::deque<Kernel> phases;
+    std::deque<Kernel> kernels;
+    Kernel scratch;
+    bool phase_open = false;
+    std::chrono::steady_clock::time_point phase_start;
+    uint64_t phase_counts[NUM_COUNTERS];
+    std::mutex merge;
+
+    void open_counters() {
+#ifdef __linux__
+        const uint32_t types[NUM_COUNTERS] = {PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HW_CACHE,
+                                              PERF_TYPE_HARDWARE};
+        const uint64_t configs[NUM_COUNTERS] = {
+            PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+            PERF_COUNT_HW_CACHE_LL | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16),
+            PERF_COUNT_HW_BRANCH_MISSES};
+        counting = true;
+        for (int c = 0; c < NUM_COUNTERS; ++c) {
+            perf_event_attr attr;
+            memset(&attr, 0, sizeof(attr));
+            attr.size = sizeof(attr);
+            attr.type = types[c];
+            attr.config = configs[c];
+            attr.inherit = 1;
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            int fd = (int)syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0);
+            fds.push_back(fd);
+            counting = counting && fd >= 0;
+        }
+#else
+        counting = false;
+#endif
+    }
+
+    void read_counts(uint64_t counts[]) const {
+        for (int c = 0; c < NUM_COUNTERS; ++c) {
+            counts[c] = 0;
+#ifdef __linux__
+            if (counting && read(fds[c], &counts[c], sizeof(uint64_t)) != sizeof(uint64_t)) counts[c] = 0;
+#endif
+        }
+    }
+
+    void start(std::chrono::steady_clock::time_point& begin, uint64_t counts[]) const {
+        read_counts(counts);
+        begin = std::chrono::steady_clock::now();
+    }
+
+    void stop(const std::chrono::steady_clock::time_point& begin, const uint64_t counts[], Sample& out) const {
+        out.seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - begin).count();
+        out.calls += 1;
+        uint64_t now[NUM_COUNTERS];
+        read_counts(now);
+        for (int c = 0; c < NUM_COUNTERS; ++c) out.counts[c] += now[c] - counts[c];
+    }
+
+    void write_sample(FILE* f, const Kernel& k, bool calls) const {
+        fprintf(f, "\"name\": \"%s\", \"seconds\": %.9f", k.name.c_str(), k.total.seconds);
+        if (calls) fprintf(f, ", \"calls\": %llu", k.total.calls);
+        for (int c = 0; c < NUM_COUNTERS; ++c) {
+            if (counting && k.counted)
+                fprintf(f, ", \"%s\": %llu", COUNTER_NAMES[c], (unsigned long long)k.total.counts[c]);
+            else fprintf(f, ", \"%s\": null", COUNTER_NAMES[c]);
+        }
+    }
+};
+
+#endif // PROFILER_H
@@ -0,0 +1,223 @@
+#ifndef RESULT_WRITER_H
+#define RESULT_WRITER_H
+
+#include <algorithm>
+#include <charconv>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <fcntl.h>
+#include <unistd.h>
+
+// Text mode would turn every '\n' of the .columns.bin doubles into "\r\n" on
+// Windows; elsewhere files are always binary.
+#ifndef O_BINARY
+#define O_BINARY 0
+#endif
+
+/*
+ * Output stage for the centrality result files.
+ *
+ * A ResultWriter formats a whole file into one buffer with std::to_chars
+ * (doubles in fixed notation with 9 decimals, as the iostream code wrote them)
+ * and hands it to the kernel with write(), instead of one flushed stream
+ * insertion per node. Fields on a line are separated by single spaces:
+ *
+ *   ResultWriter out;
+ *   out.field(heap).field(time).field(rss).end_line().end_line();
+ *   for (...) out.row(id, value);
+ *   out.save(path);
+ *
+ * Files too large to hold as text (personalized PageRank) are streamed
+ * instead: after open(path), every line that takes the buffer past CHUNK
+ * bytes sends it to the file, and close() writes the rest. A line known only
+ * at the end, such as the "memory time" header, is reserved as spaces and
+ * filled in with patch().
+ */
+
+// Writes `size` bytes to `fd`; one write() unless the kernel takes less at a
+// time.
+inline bool write_all(int fd, const char* data, size_t size) {
+    while (size > 0) {
+        ssize_t n = ::write(fd, data, size);
+        if (n <= 0) return false;
+        data += n;
+        size -= n;
+    }
+    return true;
+}
+
+// Writes `size` bytes to `path`, replacing it
+inline bool write_file(const std::string& path, const char* data, size_t size) {
+    int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_BINARY, 0644);
+    if (fd < 0) return false;
+    bool ok = write_all(fd, data, size);
+    return (::close(fd) == 0) && ok;
+}
+
+class ResultWriter {
+public:
+    static constexpr int PRECISION = 9;
+    static constexpr size_t CHUNK = 1 << 20;
+
+    ResultWriter() = default;
+    ResultWriter(const ResultWriter&) = delete;
+    ResultWriter& operator=(const ResultWriter&) = delete;
+    ResultWriter(ResultWriter&& other) noexcept { *this = std::move(other); }
+    ResultWriter& operator=(ResultWriter&& other) noexcept {
+        close();
+        buf = std::move(other.buf);
+        line_start = other.line_start;
+        fd = other.fd;
+        ok = other.ok;
+        other.fd = -1;
+        return *this;
+    }
+    ~ResultWriter() { close(); }
+
+    // Streams the file to `path` from here on (see above)
+    bool open(const std::string& path) {
+        close();
+        fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_BINARY, 0644);
+        ok = fd >= 0;
+        return ok;
+    }
+
+    // Writes what is left of a streamed file; false if any write failed
+    bool close() {
+        if (fd < 0) return ok;
+        ok = write_all(fd, buf.data(), buf.size()) && ok;
+        buf.clear();
+        ok = (::close(fd) == 0) && ok;
+        fd = -1;
+        return ok;
+    }
+
+    // Overwrites bytes [offset, offset + text.size()) of a streamed file
+    bool patch(size_t offset, const std::string& text) {
+        if (fd < 0) return false;
+        ok = write_all(fd, buf.data(), buf.size()) && ok;
+        buf.clear();
+        ok = ::lseek(fd, (off_t)offset, SEEK_SET) >= 0 && write_all(fd, text.data(), text.size()) && ok;
+        ok = ::lseek(fd, 0, SEEK_END) >= 0 && ok;
+        return ok;
+    }
+
+    void reserve(size_t bytes) { buf.reserve(bytes); }
+
+    template <class T>
+    ResultWriter& field(T value) {
+        separate();
+        char tmp[400];      // a fixed-notation double needs at most 309 + 1 + PRECISION
+        std::to_chars_result r;
+        if constexpr (std::is_floating_point<T>::value)
+            r = std::to_chars(tmp, tmp + sizeof(tmp), (double)value, std::chars_format::fixed, PRECISION);
+        else
+            r = std::to_chars(tmp, tmp + sizeof(tmp), value);
+        buf.append(tmp, r.ptr - tmp);
+        return *this;
+    }
+
+    ResultWriter& field(const std::string& text) {
+        separate();
+        buf += text;
+        return *this;
+    }
+
+    ResultWriter& field(const char* text) {
+        separate();
+        buf += text;
+        return *this;
+    }
+
+    ResultWriter& end_line() {
+        buf += '\n';
+        line_start = true;
+        if (fd >= 0 && buf.size() >= CHUNK) {
+            ok = write_all(fd, buf.data(), buf.size()) && ok;
+            buf.clear();
+        }
+        return *this;
+    }
+
+    // "id value\n"
+    ResultWriter& row(int id, double value) { return field(id).field(value).end_line(); }
+
+    const std::string& data() const { return buf; }
+
+    bool save(const std::string& path) const { return write_file(path, buf.data(), buf.size()); }
+
+private:
+    std::string buf;
+    bool line_start = true;
+    int fd = -1;        // set while streaming
+    bool ok = true;
+
+    void separate() {
+        if (!line_start) buf += ' ';
+        line_start = false;
+    }
+};
+
+/*
+ * Columnar binary results: every selected measure of one representation as a
+ * column of doubles over the same rows, for tools that map the file instead of
+ * parsing text.
+ *
+ *   ColumnsHeader | names (char[16] x columns) | ids (int32 x rows)
+ *                 | column 0 (float64 x rows) | column 1 | ...
+ *
+ * Sections start at 8-byte aligned offsets; values are in host byte order.
+ */
+const char COLUMNS_MAGIC[8] = {'C', 'E', 'N', 'T', 'C', 'O', 'L', 'S'};
+const uint32_t COLUMNS_VERSION = 1;
+const size_t COLUMN_NAME_SIZE = 16;
+
+struct ColumnsHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t num_columns;
+    uint64_t num_rows;
+    uint64_t names_offset;
+    uint64_t ids_offset;
+    uint64_t columns_offset;    // column c starts at columns_offset + c * num_rows * 8
+};
+
+struct ResultColumn {
+    std::string name;           // at most COLUMN_NAME_SIZE - 1 characters are kept
+    std::vector<double> values; // one per row
+};
+
+inline bool write_columns(const std::string& path, const std::vector<int>& ids,
+                          const std::vector<ResultColumn>& columns) {
+    auto align = [](uint64_t x) { return (x + 7) & ~7ull; };
+    ColumnsHeader h;
+    memset(&h, 0, sizeof(h));
+    memcpy(h.magic, COLUMNS_MAGIC, sizeof(h.magic));
+    h.version = COLUMNS_VERSION;
+    h.num_columns = columns.size();
+    h.num_rows = ids.size();
+    h.names_offset = align(sizeof(ColumnsHeader));
+    h.ids_offset = align(h.names_offset + columns.size() * COLUMN_NAME_SIZE);
+    h.columns_offset = align(h.ids_offset + ids.size() * sizeof(int32_t));
+
+    std::vector<char> out(h.columns_offset + columns.size() * ids.size() * sizeof(double), 0);
+    memcpy(out.data(), &h, sizeof(h));
+    for (size_t c = 0; c < columns.size(); ++c) {
+        if (columns[c].values.size() != ids.size()) return false;
+        memcpy(&out[h.names_offset + c * COLUMN_NAME_SIZE], columns[c].name.data(),
+               std::min(columns[c].name.size(), COLUMN_NAME_SIZE - 1));
+        memcpy(&out[h.columns_offset + c * ids.size() * sizeof(double)], columns[c].values.data(),
+               ids.size() * sizeof(double));
+    }
+    for (size_t r = 0; r < ids.size(); ++r) {
+        int32_t id = ids[r];
+        memcpy(&out[h.ids_offset + r * sizeof(int32_t)], &id, sizeof(id));
+    }
+    return write_file(path, out.data(), out.size());
+}
+
+#endif // RESULT_WRITER_H
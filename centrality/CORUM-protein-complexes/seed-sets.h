@@ -0,0 +1,91 @@
+#ifndef SEED_SETS_H
+#define SEED_SETS_H
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <unordered_map>
+#include "graph-reader.h"
+
+/*
+ * Named node sets used to personalize PageRank.
+ *
+ * Two formats are accepted:
+ *   - a .gmt gene set library ("name<TAB>description<TAB>gene<TAB>gene...").
+ *     Gene symbols are numbered in first-seen order over the whole file,
+ *     exactly as prepare_corum_data.py numbers them, so the sets line up with
+ *     the node IDs of the datasets generated from the same library;
+ *   - any other file is read like a .hypergraph: one set of integer node IDs
+ *     per non-blank line, named set1, set2, ... in file order.
+ */
+struct SeedSet {
+    std::string name;
+    std::vector<int> members;   // original node IDs
+};
+
+inline bool ends_with(const std::string& s, const std::string& suffix) {
+    return s.size() >= suffix.size() && s.compare(s.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+
+// Splits a line of a .gmt file on tabs after trimming it like Python's str.strip().
+inline std::vector<std::string> split_gmt_line(const std::string& line) {
+    std::vector<std::string> parts;
+    size_t first = line.find_first_not_of(" \t\r\n\v\f");
+    if (first == std::string::npos) return parts;
+    size_t last = line.find_last_not_of(" \t\r\n\v\f") + 1;
+    for (size_t start = first;; ) {
+        size_t tab = line.find('\t', start);
+        if (tab == std::string::npos || tab > last) tab = last;
+        parts.push_back(line.substr(start, tab - start));
+        if (tab == last) break;
+        start = tab + 1;
+    }
+    return parts;
+}
+
+// Reads all non-empty seed sets of `path` into `sets`. Returns false if the
+// file cannot be opened.
+inline bool load_seed_sets(const std::string& path, std::vector<SeedSet>& sets) {
+    sets.clear();
+    if (ends_with(path, ".gmt")) {
+        std::ifstream in(path);
+        if (!in.is_open()) {
+            fprintf(stderr, "ERROR: Could not open seed set file: %s\n", path.c_str());
+            return false;
+        }
+        std::unordered_map<std::string, int> gene_to_id;
+        std::string line;
+        while (std::getline(in, line)) {
+            std::vector<std::string> parts = split_gmt_line(line);
+            if (parts.size() < 3) continue;
+            SeedSet set{parts[0], {}};
+            for (size_t k = 2; k < parts.size(); ++k)
+                set.members.push_back(gene_to_id.emplace(parts[k], (int)gene_to_id.size()).first->second);
+            sets.push_back(std::move(set));
+        }
+        return true;
+    }
+
+    MappedFile file;
+    if (!file.open(path)) {
+        fprintf(stderr, "ERROR: Could not open seed set file: %s\n", path.c_str());
+        return false;
+    }
+    IntScanner in(file.data(), file.data() + file.size());
+    int lines = 0;
+    while (!in.at_end()) {
+        int u;
+        if (in.next_int(u)) {
+            SeedSet set{"set" + std::to_string(++lines), {}};
+            do {
+                set.members.push_back(u);
+            } while (in.next_int(u));
+            sets.push_back(std::move(set));
+        }
+        in.next_line();
+    }
+    return true;
+}
+
+#endif // SEED_SETS_H
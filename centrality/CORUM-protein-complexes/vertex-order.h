@@ -0,0 +1,269 @@
+#ifndef VERTEX_ORDER_H
+#define VERTEX_ORDER_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include "csr-graph.h"
+#include "id-map.h"
+
+/*
+ * Cache-locality renumbering of a loaded graph.
+ *
+ * The loaders number nodes in first-seen order, so the hyperedge nodes of the
+ * bipartite graph are interleaved with proteins and the neighbors of a vertex
+ * end up far apart in every per-vertex array. reorder_dataset() renumbers the
+ * graph, its IdMap and its mask together, so kernels traverse the permuted CSR
+ * and every `ids[j]` still names the original node:
+ *
+ *   - rcm: reverse Cuthill-McKee. Each component is traversed breadth-first
+ *     from a pseudo-peripheral vertex, neighbors in increasing degree, and the
+ *     whole order is reversed, which keeps the neighbor-ID bandwidth small.
+ *   - gorder: Gorder's greedy window (Wei et al.). The next vertex is the one
+ *     with the most neighbor and sibling (common neighbor) relations to the
+ *     last `window` placed vertices; siblings are not counted through hubs
+ *     of more than sqrt(n) neighbors. Its cost grows with the sum of the
+ *     squared degrees, so it is by far the slowest on dense clique expansions.
+ *   - degree: hub sort. Vertices of above-average degree come first, by
+ *     decreasing degree, the others keep their load order.
+ *
+ * Exact results do not depend on the numbering, up to the rounding of sums
+ * taken in a different order. Sampled betweenness and HyperBall draw their
+ * randomness per index, so their estimates do.
+ */
+enum class VertexOrder { NONE, RCM, GORDER, DEGREE };
+
+const char* const VERTEX_ORDER_NAMES[] = {"none", "rcm", "gorder", "degree"};
+
+inline bool parse_vertex_order(const std::string& name, VertexOrder& order) {
+    for (int k = 0; k < 4; ++k)
+        if (name == VERTEX_ORDER_NAMES[k]) {
+            order = (VertexOrder)k;
+            return true;
+        }
+    return false;
+}
+
+// Mean |u - v| over all stored arcs u -> v
+inline double average_neighbor_gap(const CSRGraph& g) {
+    double sum = 0;
+    for (int v = 0; v < g.size(); ++v)
+        for (int u : g.neighbors(v))
+            sum += std::abs(u - v);
+    return g.num_arcs() > 0 ? sum / g.num_arcs() : 0;
+}
+
+// Mean log2(1 + gap) between consecutive entries of the sorted neighbor
+// lists: how far a row scan jumps through the per-vertex arrays
+inline double average_log_gap(const CSRGraph& g) {
+    double sum = 0;
+    long long gaps = 0;
+    std::vector<int> row;
+    for (int v = 0; v < g.size(); ++v) {
+        row.assign(g.neighbors(v).begin(), g.neighbors(v).end());
+        std::sort(row.begin(), row.end());
+        for (size_t k = 1; k < row.size(); ++k)
+            sum += std::log2(1.0 + row[k] - row[k - 1]);
+        gaps += row.size() > 1 ? row.size() - 1 : 0;
+    }
+    return gaps > 0 ? sum / gaps : 0;
+}
+
+// Vertices in reverse Cuthill-McKee order
+inline std::vector<int> rcm_order(const CSRGraph& g) {
+    int n = g.size();
+    std::vector<int> order, level(n, -1), by_degree(n);
+    std::vector<char> placed(n, 0);
+    order.reserve(n);
+    for (int v = 0; v < n; ++v)
+        by_degree[v] = v;
+    std::stable_sort(by_degree.begin(), by_degree.end(), [&](int a, int b) { return g.degree(a) < g.degree(b); });
+
+    // Breadth-first levels of the component of `source`, into `reach`;
+    // returns its last vertex of minimum degree within the deepest level
+    std::vector<int> reach;
+    auto farthest = [&](int source, int& depth) {
+        reach.assign(1, source);
+        level[source] = 0;
+        for (size_t head = 0; head < reach.size(); ++head)
+            for (int u : g.neighbors(reach[head]))
+                if (level[u] < 0) {
+                    level[u] = level[reach[head]] + 1;
+                    reach.push_back(u);
+                }
+        depth = level[reach.back()];
+        int best = reach.back();
+        for (int v : reach)
+            if (level[v] == depth && g.degree(v) < g.degree(best)) best = v;
+        for (int v : reach)
+            level[v] = -1;
+        return best;
+    };
+
+    std::vector<int> next;
+    for (int start : by_degree) {
+        if (placed[start]) continue;
+        // Walk to a pseudo-peripheral vertex while the eccentricity grows
+        int depth, far_depth;
+        int far = farthest(start, depth);
+        while (far != start) {
+            int candidate = farthest(far, far_depth);
+            if (far_depth <= depth) break;
+            start = far;
+            far = candidate;
+            depth = far_depth;
+        }
+        size_t head = order.size();
+        placed[start] = 1;
+        order.push_back(start);
+        for (; head < order.size(); ++head) {
+            next.clear();
+            for (int u : g.neighbors(order[head]))
+                if (!placed[u]) {
+                    placed[u] = 1;
+                    next.push_back(u);
+                }
+            std::stable_sort(next.begin(), next.end(), [&](int a, int b) { return g.degree(a) < g.degree(b); });
+            order.insert(order.end(), next.begin(), next.end());
+        }
+    }
+    std::reverse(order.begin(), order.end());
+    return order;
+}
+
+// Vertices in Gorder's greedy order for a window of `window` vertices
+inline std::vector<int> gorder_order(const CSRGraph& g, int window = 5) {
+    int n = g.size();
+    int hub = std::max(1, (int)std::sqrt((double)n));
+    std::vector<int> order;
+    order.reserve(n);
+
+    // Unit heap: scores only move by one, so the unplaced vertices sit in
+    // doubly linked lists per score (heads in `bucket`) and `top` only has
+    // to step down past empty lists. The score-0 list starts in decreasing
+    // degree, so each component starts at its largest hub.
+    const int NIL = -1;
+    std::vector<int> score(n, 0), prev(n, NIL), next(n, NIL), bucket(1, NIL);
+    std::vector<char> placed(n, 0);
+    int top = 0;
+    auto unlink = [&](int v) {
+        if (prev[v] != NIL) next[prev[v]] = next[v];
+        else bucket[score[v]] = next[v];
+        if (next[v] != NIL) prev[next[v]] = prev[v];
+    };
+    auto link = [&](int v) {
+        if (score[v] >= (int)bucket.size()) bucket.resize(score[v] + 1, NIL);
+        prev[v] = NIL;
+        next[v] = bucket[score[v]];
+        if (next[v] != NIL) prev[next[v]] = v;
+        bucket[score[v]] = v;
+        top = std::max(top, score[v]);
+    };
+    std::vector<int> by_degree(n);
+    for (int v = 0; v < n; ++v)
+        by_degree[v] = v;
+    std::stable_sort(by_degree.begin(), by_degree.end(), [&](int a, int b) { return g.degree(a) < g.degree(b); });
+    for (int v : by_degree)
+        link(v);
+
+    auto bump = [&](int u, int delta) {
+        if (placed[u]) return;
+        unlink(u);
+        score[u] += delta;
+        link(u);
+    };
+    // Adds (1) or removes (-1) the relations of v to the unplaced vertices
+    auto relate = [&](int v, int delta) {
+        for (int u : g.neighbors(v)) {
+            bump(u, delta);
+            if (g.degree(u) > hub) continue;
+            for (int w : g.neighbors(u))
+                if (w != v) bump(w, delta);
+        }
+    };
+
+    while ((int)order.size() < n) {
+        while (bucket[top] == NIL)
+            --top;
+        int v = bucket[top];
+        unlink(v);
+        placed[v] = 1;
+        order.push_back(v);
+        relate(v, 1);
+        if ((int)order.size() > window) relate(order[order.size() - 1 - window], -1);
+    }
+    return order;
+}
+
+// Vertices in hub-sorted order
+inline std::vector<int> degree_order(const CSRGraph& g) {
+    int n = g.size();
+    double average = n > 0 ? (double)g.num_arcs() / n : 0;
+    std::vector<int> order;
+    order.reserve(n);
+    for (int v = 0; v < n; ++v)
+        if (g.degree(v) > average) order.push_back(v);
+    std::stable_sort(order.begin(), order.end(), [&](int a, int b) { return g.degree(a) > g.degree(b); });
+    for (int v = 0; v < n; ++v)
+        if (g.degree(v) <= average) order.push_back(v);
+    return order;
+}
+
+// Outcome of reorder_dataset(): rank[v] is the new index of the node loaded
+// as v (empty if nothing was renumbered)
+struct Reordering {
+    VertexOrder order = VertexOrder::NONE;
+    std::vector<int> rank;
+    double gap_before = 0;
+    double gap_after = 0;
+    double log_gap_before = 0;
+    double log_gap_after = 0;
+
+    // Index of the node at load position k; nodes added after the renumbering
+    // (incremental updates) keep their index
+    int index(int k) const { return k < (int)rank.size() ? rank[k] : k; }
+
+    // "Vertex order ...: average neighbor-ID gap ..." line, empty for NONE
+    std::string report() const {
+        if (order == VertexOrder::NONE) return "";
+        char line[200];
+        snprintf(line, sizeof(line),
+                 "Vertex order %s: average neighbor-ID gap %.1f -> %.1f, log2 gap within rows %.2f -> %.2f\n",
+                 VERTEX_ORDER_NAMES[(int)order], gap_before, gap_after, log_gap_before, log_gap_after);
+        return line;
+    }
+};
+
+// Renumbers `graph`, `ids` and `mask` by `order`
+inline Reordering reorder_dataset(VertexOrder order, IdMap& ids, CSRGraph& graph, std::vector<char>& mask) {
+    Reordering result;
+    if (order == VertexOrder::NONE) return result;
+    std::vector<int> sequence = order == VertexOrder::RCM    ? rcm_order(graph)
+                                : order == VertexOrder::GORDER ? gorder_order(graph)
+                                                               : degree_order(graph);
+    int n = graph.size();
+    result.order = order;
+    result.rank.assign(n, 0);
+    for (int x = 0; x < n; ++x)
+        result.rank[sequence[x]] = x;
+    result.gap_before = average_neighbor_gap(graph);
+    result.log_gap_before = average_log_gap(graph);
+    graph = graph.permuted(result.rank);
+    result.gap_after = average_neighbor_gap(graph);
+    result.log_gap_after = average_log_gap(graph);
+
+    IdMap renamed;
+    std::vector<char> renamed_mask(n);
+    for (int x = 0; x < n; ++x) {
+        renamed.intern(ids[sequence[x]]);
+        renamed_mask[x] = mask[sequence[x]];
+    }
+    ids = std::move(renamed);
+    mask = std::move(renamed_mask);
+    return result;
+}
+
+#endif // VERTEX_ORDER_H
@@ -0,0 +1,47 @@
+#ifndef VISIT_MARKS_H
+#define VISIT_MARKS_H
+
+#include <algorithm>
+#include <vector>
+
+/*
+ * "Visited in the current traversal" flags that clear in O(1).
+ *
+ * Each vertex keeps the epoch in which it was last marked; a vertex is marked
+ * iff its stamp equals the current epoch, so starting the next traversal is a
+ * counter increment instead of a pass over every vertex. The stamps are only
+ * wiped when the counter wraps around, once every 2^32 - 1 traversals. Scratch
+ * arrays next to the marks (levels, path counts, dependencies) are initialized
+ * when mark() first reports a vertex, so per-source cost follows the part of
+ * the graph the traversal reaches.
+ */
+class VisitMarks {
+public:
+    // Makes room for vertices [0, n); vertices added are unmarked.
+    void resize(int n) {
+        if (n > (int)stamp.size()) stamp.resize(n, 0);
+    }
+
+    // Starts a new traversal: every vertex becomes unmarked.
+    void clear() {
+        if (++epoch == 0) {
+            std::fill(stamp.begin(), stamp.end(), 0);
+            epoch = 1;
+        }
+    }
+
+    bool marked(int v) const { return stamp[v] == epoch; }
+
+    // Marks v; returns false if it was already marked in this traversal.
+    bool mark(int v) {
+        if (stamp[v] == epoch) return false;
+        stamp[v] = epoch;
+        return true;
+    }
+
+private:
+    std::vector<unsigned> stamp;
+    unsigned epoch = 1;
+};
+
+#endif // VISIT_MARKS_H